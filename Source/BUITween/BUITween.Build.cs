@@ -20,9 +20,11 @@ public class BUITween : ModuleRules
 			new string[]
 			{
 				"CoreUObject",
+				"DeveloperSettings",
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"TraceLog",
 				"UMG"
 			}
 		);
@@ -0,0 +1,279 @@
+#include "BUIEasing.h"
+#include "Math/VectorRegister.h"
+
+namespace BUIEasingBatch
+{
+	// Runs Fn over whole registers of normalised time and returns how many lanes were written
+	template<typename VectorFnType>
+	FORCEINLINE int32 EaseVectorized( const float* Time, const float* Duration, float* Out, int32 Count, VectorFnType VectorFn )
+	{
+		int32 i = 0;
+		for ( ; i + 4 <= Count; i += 4 )
+		{
+			const VectorRegister T = VectorDivide( VectorLoad( Time + i ), VectorLoad( Duration + i ) );
+			VectorStore( VectorFn( T ), Out + i );
+		}
+		return i;
+	}
+
+	// Penner's InOut curves run the In half on 2t and the Out half on 2t-2, then pick per lane
+	template<typename InFnType, typename OutFnType>
+	FORCEINLINE VectorRegister InOut( const VectorRegister& T, InFnType InFn, OutFnType OutFn )
+	{
+		const VectorRegister Two = VectorSetFloat1( 2.0f );
+		const VectorRegister U = VectorMultiply( T, Two );
+		const VectorRegister FirstHalf = InFn( U );
+		const VectorRegister SecondHalf = OutFn( VectorSubtract( U, Two ) );
+		return VectorSelect( VectorCompareLT( U, VectorOne() ), FirstHalf, SecondHalf );
+	}
+}
+
+FBUIEasingFunction FBUIEasing::Resolve( EBUIEasingType Type )
+{
+	static const FBUIEasingFunction Functions[ NumEasingTypes ] =
+	{
+		&TBUIEasing<EBUIEasingType::Linear>::Eval,
+		&TBUIEasing<EBUIEasingType::Smoothstep>::Eval,
+		&TBUIEasing<EBUIEasingType::InSine>::Eval,
+		&TBUIEasing<EBUIEasingType::OutSine>::Eval,
+		&TBUIEasing<EBUIEasingType::InOutSine>::Eval,
+		&TBUIEasing<EBUIEasingType::InQuad>::Eval,
+		&TBUIEasing<EBUIEasingType::OutQuad>::Eval,
+		&TBUIEasing<EBUIEasingType::InOutQuad>::Eval,
+		&TBUIEasing<EBUIEasingType::InCubic>::Eval,
+		&TBUIEasing<EBUIEasingType::OutCubic>::Eval,
+		&TBUIEasing<EBUIEasingType::InOutCubic>::Eval,
+		&TBUIEasing<EBUIEasingType::InQuart>::Eval,
+		&TBUIEasing<EBUIEasingType::OutQuart>::Eval,
+		&TBUIEasing<EBUIEasingType::InOutQuart>::Eval,
+		&TBUIEasing<EBUIEasingType::InQuint>::Eval,
+		&TBUIEasing<EBUIEasingType::OutQuint>::Eval,
+		&TBUIEasing<EBUIEasingType::InOutQuint>::Eval,
+		&TBUIEasing<EBUIEasingType::InExpo>::Eval,
+		&TBUIEasing<EBUIEasingType::OutExpo>::Eval,
+		&TBUIEasing<EBUIEasingType::InOutExpo>::Eval,
+		&TBUIEasing<EBUIEasingType::InCirc>::Eval,
+		&TBUIEasing<EBUIEasingType::OutCirc>::Eval,
+		&TBUIEasing<EBUIEasingType::InOutCirc>::Eval,
+		&TBUIEasing<EBUIEasingType::InElastic>::Eval,
+		&TBUIEasing<EBUIEasingType::OutElastic>::Eval,
+		&TBUIEasing<EBUIEasingType::InOutElastic>::Eval,
+		&TBUIEasing<EBUIEasingType::InBack>::Eval,
+		&TBUIEasing<EBUIEasingType::OutBack>::Eval,
+		&TBUIEasing<EBUIEasingType::InOutBack>::Eval,
+	};
+	return Functions[ (int32)Type ];
+}
+
+
+void FBUIEasing::EaseBatch( EBUIEasingType Type, const float* Time, const float* Duration, float* Out, int32 Count, float overshootOrAmplitude, float period )
+{
+	using namespace BUIEasingBatch;
+
+	const VectorRegister Zero = VectorZero();
+	const VectorRegister One = VectorOne();
+	const VectorRegister Half = VectorSetFloat1( 0.5f );
+	const VectorRegister Two = VectorSetFloat1( 2.0f );
+
+	int32 NumDone = 0;
+	switch ( Type )
+	{
+		case EBUIEasingType::Linear:
+			NumDone = EaseVectorized( Time, Duration, Out, Count, []( const VectorRegister& T ) { return T; } );
+			break;
+		case EBUIEasingType::Smoothstep:
+			NumDone = EaseVectorized( Time, Duration, Out, Count, [&]( const VectorRegister& T ) {
+				const VectorRegister X = VectorMin( VectorMax( T, Zero ), One );
+				return VectorMultiply( VectorMultiply( X, X ), VectorSubtract( VectorSetFloat1( 3.0f ), VectorMultiply( Two, X ) ) );
+			} );
+			break;
+		case EBUIEasingType::InSine:
+			NumDone = EaseVectorized( Time, Duration, Out, Count, [&]( const VectorRegister& T ) {
+				return VectorSubtract( One, VectorCos( VectorMultiply( T, VectorSetFloat1( HALF_PI ) ) ) );
+			} );
+			break;
+		case EBUIEasingType::OutSine:
+			NumDone = EaseVectorized( Time, Duration, Out, Count, [&]( const VectorRegister& T ) {
+				return VectorSin( VectorMultiply( T, VectorSetFloat1( HALF_PI ) ) );
+			} );
+			break;
+		case EBUIEasingType::InOutSine:
+			NumDone = EaseVectorized( Time, Duration, Out, Count, [&]( const VectorRegister& T ) {
+				return VectorMultiply( Half, VectorSubtract( One, VectorCos( VectorMultiply( T, VectorSetFloat1( PI ) ) ) ) );
+			} );
+			break;
+		case EBUIEasingType::InQuad:
+			NumDone = EaseVectorized( Time, Duration, Out, Count, []( const VectorRegister& T ) {
+				return VectorMultiply( T, T );
+			} );
+			break;
+		case EBUIEasingType::OutQuad:
+			NumDone = EaseVectorized( Time, Duration, Out, Count, [&]( const VectorRegister& T ) {
+				return VectorMultiply( T, VectorSubtract( Two, T ) );
+			} );
+			break;
+		case EBUIEasingType::InOutQuad:
+			NumDone = EaseVectorized( Time, Duration, Out, Count, [&]( const VectorRegister& T ) {
+				// Second half uses u = 2t-2 here, which expands to 1 - 0.5 * u^2
+				return InOut( T,
+					[&]( const VectorRegister& U ) { return VectorMultiply( Half, VectorMultiply( U, U ) ); },
+					[&]( const VectorRegister& U ) { return VectorSubtract( One, VectorMultiply( Half, VectorMultiply( U, U ) ) ); } );
+			} );
+			break;
+		case EBUIEasingType::InCubic:
+			NumDone = EaseVectorized( Time, Duration, Out, Count, []( const VectorRegister& T ) {
+				return VectorMultiply( VectorMultiply( T, T ), T );
+			} );
+			break;
+		case EBUIEasingType::OutCubic:
+			NumDone = EaseVectorized( Time, Duration, Out, Count, [&]( const VectorRegister& T ) {
+				const VectorRegister U = VectorSubtract( T, One );
+				return VectorMultiplyAdd( VectorMultiply( U, U ), U, One );
+			} );
+			break;
+		case EBUIEasingType::InOutCubic:
+			NumDone = EaseVectorized( Time, Duration, Out, Count, [&]( const VectorRegister& T ) {
+				return InOut( T,
+					[&]( const VectorRegister& U ) { return VectorMultiply( Half, VectorMultiply( VectorMultiply( U, U ), U ) ); },
+					[&]( const VectorRegister& U ) { return VectorMultiply( Half, VectorMultiplyAdd( VectorMultiply( U, U ), U, Two ) ); } );
+			} );
+			break;
+		case EBUIEasingType::InQuart:
+			NumDone = EaseVectorized( Time, Duration, Out, Count, []( const VectorRegister& T ) {
+				const VectorRegister T2 = VectorMultiply( T, T );
+				return VectorMultiply( T2, T2 );
+			} );
+			break;
+		case EBUIEasingType::OutQuart:
+			NumDone = EaseVectorized( Time, Duration, Out, Count, [&]( const VectorRegister& T ) {
+				const VectorRegister U = VectorSubtract( T, One );
+				const VectorRegister U2 = VectorMultiply( U, U );
+				return VectorSubtract( One, VectorMultiply( U2, U2 ) );
+			} );
+			break;
+		case EBUIEasingType::InOutQuart:
+			NumDone = EaseVectorized( Time, Duration, Out, Count, [&]( const VectorRegister& T ) {
+				return InOut( T,
+					[&]( const VectorRegister& U ) { const VectorRegister U2 = VectorMultiply( U, U ); return VectorMultiply( Half, VectorMultiply( U2, U2 ) ); },
+					[&]( const VectorRegister& U ) { const VectorRegister U2 = VectorMultiply( U, U ); return VectorSubtract( One, VectorMultiply( Half, VectorMultiply( U2, U2 ) ) ); } );
+			} );
+			break;
+		case EBUIEasingType::InQuint:
+			NumDone = EaseVectorized( Time, Duration, Out, Count, []( const VectorRegister& T ) {
+				const VectorRegister T2 = VectorMultiply( T, T );
+				return VectorMultiply( VectorMultiply( T2, T2 ), T );
+			} );
+			break;
+		case EBUIEasingType::OutQuint:
+			NumDone = EaseVectorized( Time, Duration, Out, Count, [&]( const VectorRegister& T ) {
+				const VectorRegister U = VectorSubtract( T, One );
+				const VectorRegister U2 = VectorMultiply( U, U );
+				return VectorMultiplyAdd( VectorMultiply( U2, U2 ), U, One );
+			} );
+			break;
+		case EBUIEasingType::InOutQuint:
+			NumDone = EaseVectorized( Time, Duration, Out, Count, [&]( const VectorRegister& T ) {
+				return InOut( T,
+					[&]( const VectorRegister& U ) { const VectorRegister U2 = VectorMultiply( U, U ); return VectorMultiply( Half, VectorMultiply( VectorMultiply( U2, U2 ), U ) ); },
+					[&]( const VectorRegister& U ) { const VectorRegister U2 = VectorMultiply( U, U ); return VectorMultiply( Half, VectorMultiplyAdd( VectorMultiply( U2, U2 ), U, Two ) ); } );
+			} );
+			break;
+		case EBUIEasingType::InBack:
+		{
+			const VectorRegister S = VectorSetFloat1( overshootOrAmplitude );
+			const VectorRegister S1 = VectorSetFloat1( overshootOrAmplitude + 1 );
+			NumDone = EaseVectorized( Time, Duration, Out, Count, [&]( const VectorRegister& T ) {
+				return VectorMultiply( VectorMultiply( T, T ), VectorSubtract( VectorMultiply( S1, T ), S ) );
+			} );
+			break;
+		}
+		case EBUIEasingType::OutBack:
+		{
+			const VectorRegister S = VectorSetFloat1( overshootOrAmplitude );
+			const VectorRegister S1 = VectorSetFloat1( overshootOrAmplitude + 1 );
+			NumDone = EaseVectorized( Time, Duration, Out, Count, [&]( const VectorRegister& T ) {
+				const VectorRegister U = VectorSubtract( T, One );
+				return VectorMultiplyAdd( VectorMultiply( U, U ), VectorMultiplyAdd( S1, U, S ), One );
+			} );
+			break;
+		}
+		case EBUIEasingType::InOutBack:
+		{
+			const float S = overshootOrAmplitude * 1.525f;
+			const VectorRegister VS = VectorSetFloat1( S );
+			const VectorRegister VS1 = VectorSetFloat1( S + 1 );
+			NumDone = EaseVectorized( Time, Duration, Out, Count, [&]( const VectorRegister& T ) {
+				return InOut( T,
+					[&]( const VectorRegister& U ) { return VectorMultiply( Half, VectorMultiply( VectorMultiply( U, U ), VectorSubtract( VectorMultiply( VS1, U ), VS ) ) ); },
+					[&]( const VectorRegister& U ) { return VectorMultiply( Half, VectorMultiplyAdd( VectorMultiply( U, U ), VectorMultiplyAdd( VS1, U, VS ), Two ) ); } );
+			} );
+			break;
+		}
+		default:
+			// Expo, Circ and Elastic have special cases at the end points that don't vectorise cleanly, they
+			// go through the resolved scalar function below
+			break;
+	}
+
+	const FBUIEasingFunction Function = Resolve( Type );
+	for ( int32 i = NumDone; i < Count; ++i )
+	{
+		Out[ i ] = Function( Time[ i ] / Duration[ i ], overshootOrAmplitude, period / Duration[ i ] );
+	}
+}
+
+
+float FBUIEasing::CubicBezier( float t, float X1, float Y1, float X2, float Y2 )
+{
+	// x stays monotonic in the curve parameter as long as the control points are inside [0, 1] in time
+	X1 = FMath::Clamp( X1, 0.0f, 1.0f );
+	X2 = FMath::Clamp( X2, 0.0f, 1.0f );
+	t = FMath::Clamp( t, 0.0f, 1.0f );
+
+	// Polynomial coefficients of each axis, B(s) = ( ( A * s + B ) * s + C ) * s
+	const float CX = 3 * X1;
+	const float BX = 3 * ( X2 - X1 ) - CX;
+	const float AX = 1 - CX - BX;
+	const float CY = 3 * Y1;
+	const float BY = 3 * ( Y2 - Y1 ) - CY;
+	const float AY = 1 - CY - BY;
+	auto SampleX = [&]( float S ) { return ( ( AX * S + BX ) * S + CX ) * S; };
+
+	// Newton's method converges in a few steps almost everywhere, bisect where the slope is too flat for it
+	constexpr float Epsilon = 1.e-6f;
+	float S = t;
+	bool bSolved = false;
+	for ( int32 i = 0; i < 8; ++i )
+	{
+		const float Error = SampleX( S ) - t;
+		if ( FMath::Abs( Error ) < Epsilon )
+		{
+			bSolved = true;
+			break;
+		}
+		const float Slope = ( 3 * AX * S + 2 * BX ) * S + CX;
+		if ( FMath::Abs( Slope ) < Epsilon )
+		{
+			break;
+		}
+		S -= Error / Slope;
+	}
+	if ( !bSolved || S < 0 || S > 1 )
+	{
+		float Low = 0;
+		float High = 1;
+		S = t;
+		for ( int32 i = 0; i < 32; ++i )
+		{
+			const float X = SampleX( S );
+			if ( FMath::Abs( X - t ) < Epsilon )
+			{
+				break;
+			}
+			( X < t ? Low : High ) = S;
+			S = ( Low + High ) * 0.5f;
+		}
+	}
+
+	return ( ( AY * S + BY ) * S + CY ) * S;
+}
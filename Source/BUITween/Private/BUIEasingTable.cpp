@@ -0,0 +1,258 @@
+#include "BUIEasingTable.h"
+#include "BUITweenInstance.h"
+#include "Curves/CurveFloat.h"
+
+TMap< FBUIEasingTableCache::FKey, FBUIEasingTablePtr > FBUIEasingTableCache::Tables;
+TMap< FBUIEasingTableCache::FCustomKey, FBUIEasingTablePtr > FBUIEasingTableCache::CustomTables;
+TMap< FObjectKey, FBUIEasingTableCache::FCurveEntry > FBUIEasingTableCache::CurveTables;
+int32 FBUIEasingTableCache::NextTrimAt = 0;
+
+// Below this many tables the cache never trims, so the handful every project uses aren't rebaked
+static const int32 MinTablesBeforeTrim = 64;
+
+float FBUIEasingTable::Bake( TFunctionRef<float( float )> Fn, EBUIEasingTableInterpolation InInterpolation, int32 InResolution, int32 InMaxResolution, float InMaxError )
+{
+	Interpolation = InInterpolation;
+	Resolution = FMath::Max( InResolution, 1 );
+	InMaxResolution = FMath::Max( InMaxResolution, Resolution );
+
+	Resample( Fn );
+	MaxError = MeasureMaxError( Fn );
+	while ( MaxError > InMaxError && Resolution * 2 <= InMaxResolution )
+	{
+		Resolution *= 2;
+		Resample( Fn );
+		MaxError = MeasureMaxError( Fn );
+	}
+
+	return MaxError;
+}
+
+
+void FBUIEasingTable::Resample( TFunctionRef<float( float )> Fn )
+{
+	InvResolution = 1.0f / Resolution;
+
+	Values.SetNumUninitialized( Resolution + 1 );
+	for ( int32 i = 0; i <= Resolution; ++i )
+	{
+		Values[ i ] = Fn( i * InvResolution );
+	}
+
+	Slopes.Reset();
+	if ( Interpolation == EBUIEasingTableInterpolation::Hermite )
+	{
+		// Finite differences against the curve itself rather than the neighbouring samples, so the slopes
+		// stay accurate however coarse the table is. One-sided at the ends so we never sample outside [0, 1].
+		const float H = FMath::Min( 1.e-3f, InvResolution * 0.25f );
+		Slopes.SetNumUninitialized( Resolution + 1 );
+		for ( int32 i = 0; i <= Resolution; ++i )
+		{
+			const float t = i * InvResolution;
+			const float T0 = FMath::Max( t - H, 0.0f );
+			const float T1 = FMath::Min( t + H, 1.0f );
+			Slopes[ i ] = ( Fn( T1 ) - Fn( T0 ) ) / ( T1 - T0 );
+		}
+	}
+}
+
+
+float FBUIEasingTable::MeasureMaxError( TFunctionRef<float( float )> Fn, int32 NumProbesPerInterval ) const
+{
+	float WorstError = 0;
+	const int32 NumProbes = Resolution * NumProbesPerInterval;
+	for ( int32 i = 0; i <= NumProbes; ++i )
+	{
+		const float t = (float)i / NumProbes;
+		WorstError = FMath::Max( WorstError, FMath::Abs( Sample( t ) - Fn( t ) ) );
+	}
+	return WorstError;
+}
+
+
+FBUIEasingTablePtr FBUIEasingTableCache::Get( EBUIEasingType Type, float overshootOrAmplitude, float period )
+{
+	const FKey Key{ Type, overshootOrAmplitude, period };
+	if ( const FBUIEasingTablePtr* Existing = Tables.Find( Key ) )
+	{
+		return *Existing;
+	}
+
+	TrimIfGrown();
+	auto EaseFn = [Type, overshootOrAmplitude, period]( float t ) {
+		return FBUIEasing::Ease( Type, t, 1.0f, overshootOrAmplitude, period );
+	};
+	return Tables.Add( Key, Bake( EaseFn, FString::Printf( TEXT( "%d (%f, %f)" ), (int32)Type, overshootOrAmplitude, period ) ) );
+}
+
+
+FBUIEasingTablePtr FBUIEasingTableCache::Bake( TFunctionRef<float( float )> Fn, const FString& Name )
+{
+	const UBUITweenSettings* Settings = GetDefault<UBUITweenSettings>();
+	TSharedRef< FBUIEasingTable > Table = MakeShared< FBUIEasingTable >();
+	const float Error = Table->Bake( Fn, Settings->EasingTableInterpolation, Settings->EasingTableResolution, Settings->MaxEasingTableResolution, Settings->MaxEasingTableError );
+
+	if ( Error > Settings->MaxEasingTableError )
+	{
+		UE_LOG( LogBUITween, Warning, TEXT( "Easing table for %s is off by %f at %d samples, above MaxEasingTableError %f" ),
+			*Name, Error, Table->GetResolution(), Settings->MaxEasingTableError );
+	}
+	else
+	{
+		UE_LOG( LogBUITween, Verbose, TEXT( "Baked easing table for %s at %d samples, max error %f" ),
+			*Name, Table->GetResolution(), Error );
+	}
+	return Table;
+}
+
+
+FBUIEasingTablePtr FBUIEasingTableCache::GetCustom( FCustomKey&& Key, TFunctionRef<float( float )> Fn, TFunctionRef<FString()> GetName )
+{
+	if ( const FBUIEasingTablePtr* Existing = CustomTables.Find( Key ) )
+	{
+		return *Existing;
+	}
+
+	TrimIfGrown();
+	return CustomTables.Add( MoveTemp( Key ), Bake( Fn, GetName() ) );
+}
+
+
+uint32 FBUIEasingTableCache::GetCurveStamp( const UCurveFloat& Curve )
+{
+	// Curves can be edited while tweens play in the editor, and a cooked game can change a curve's keys from
+	// code, so everything the table is baked from goes in
+	const TArray< FRichCurveKey >& Keys = Curve.FloatCurve.GetConstRefOfKeys();
+	uint32 Stamp = HashCombine( ::GetTypeHash( Keys.Num() ), ::GetTypeHash( Curve.FloatCurve.DefaultValue ) );
+	for ( const FRichCurveKey& CurveKey : Keys )
+	{
+		Stamp = HashCombine( Stamp, HashCombine( HashCombine( ::GetTypeHash( CurveKey.Time ), ::GetTypeHash( CurveKey.Value ) ),
+			HashCombine( ::GetTypeHash( CurveKey.ArriveTangent ), ::GetTypeHash( CurveKey.LeaveTangent ) ) ) );
+		Stamp = HashCombine( Stamp, HashCombine( HashCombine( ::GetTypeHash( CurveKey.ArriveTangentWeight ), ::GetTypeHash( CurveKey.LeaveTangentWeight ) ),
+			::GetTypeHash( ( (uint32)CurveKey.InterpMode << 16 ) | ( (uint32)CurveKey.TangentMode << 8 ) | (uint32)CurveKey.TangentWeightMode ) ) );
+	}
+	return Stamp;
+}
+
+
+FBUIEasingTablePtr FBUIEasingTableCache::GetForCurve( const UCurveFloat& Curve )
+{
+	const FObjectKey CurveObject( &Curve );
+	const uint32 Stamp = GetCurveStamp( Curve );
+	if ( const FCurveEntry* Entry = CurveTables.Find( CurveObject ) )
+	{
+		FBUIEasingTablePtr Table = Entry->Table.Pin();
+		if ( Table.IsValid() && Entry->Stamp == Stamp )
+		{
+			return Table;
+		}
+	}
+
+	const FRichCurve& RichCurve = Curve.FloatCurve;
+	const TArray< FRichCurveKey >& Keys = RichCurve.GetConstRefOfKeys();
+
+	// Everything Eval reads between the first and last key. The leading 0 keeps curves apart from beziers.
+	FCustomKey Key;
+	Key.Shape.Reserve( 2 + Keys.Num() * 9 );
+	Key.Shape.Add( 0 );
+	Key.Shape.Add( RichCurve.DefaultValue );
+	for ( const FRichCurveKey& CurveKey : Keys )
+	{
+		Key.Shape.Add( CurveKey.Time );
+		Key.Shape.Add( CurveKey.Value );
+		Key.Shape.Add( CurveKey.ArriveTangent );
+		Key.Shape.Add( CurveKey.LeaveTangent );
+		Key.Shape.Add( CurveKey.ArriveTangentWeight );
+		Key.Shape.Add( CurveKey.LeaveTangentWeight );
+		Key.Shape.Add( (float)CurveKey.InterpMode );
+		Key.Shape.Add( (float)CurveKey.TangentMode );
+		Key.Shape.Add( (float)CurveKey.TangentWeightMode );
+	}
+
+	float MinTime = 0;
+	float MaxTime = 1;
+	if ( Keys.Num() > 1 )
+	{
+		RichCurve.GetTimeRange( MinTime, MaxTime );
+	}
+	auto CurveFn = [&RichCurve, MinTime, MaxTime]( float t ) {
+		return RichCurve.Eval( FMath::Lerp( MinTime, MaxTime, t ) );
+	};
+	FBUIEasingTablePtr Table = GetCustom( MoveTemp( Key ), CurveFn, [&Curve]() { return Curve.GetPathName(); } );
+	CurveTables.Add( CurveObject, { Table, Stamp } );
+	return Table;
+}
+
+
+FBUIEasingTablePtr FBUIEasingTableCache::GetForBezier( float X1, float Y1, float X2, float Y2 )
+{
+	FCustomKey Key;
+	Key.Shape = { 1, X1, Y1, X2, Y2 };
+	auto BezierFn = [X1, Y1, X2, Y2]( float t ) {
+		return FBUIEasing::CubicBezier( t, X1, Y1, X2, Y2 );
+	};
+	return GetCustom( MoveTemp( Key ), BezierFn, [=]() { return FString::Printf( TEXT( "cubic-bezier(%f, %f, %f, %f)" ), X1, Y1, X2, Y2 ); } );
+}
+
+
+FBUIEasingTablePtr FBUIEasingTableCache::GetForTween( EBUIEasingType Type, float Duration, float overshootOrAmplitude )
+{
+	switch ( Type )
+	{
+		case EBUIEasingType::InElastic:
+		case EBUIEasingType::OutElastic:
+		case EBUIEasingType::InOutElastic:
+			// Ease( t, D, a, p ) == Ease( t / D, 1, a, p / D ) for the elastic curves
+			return Get( Type, overshootOrAmplitude, Duration > 0 ? 1.0f / Duration : 1.0f );
+		default:
+			return Get( Type, overshootOrAmplitude );
+	}
+}
+
+
+void FBUIEasingTableCache::TrimIfGrown()
+{
+	if ( Num() >= FMath::Max( NextTrimAt, MinTablesBeforeTrim ) )
+	{
+		Trim();
+	}
+}
+
+
+void FBUIEasingTableCache::Trim()
+{
+	// A table only the cache refers to isn't in use by any tween
+	for ( auto It = Tables.CreateIterator(); It; ++It )
+	{
+		if ( It.Value().IsUnique() )
+		{
+			It.RemoveCurrent();
+		}
+	}
+	for ( auto It = CustomTables.CreateIterator(); It; ++It )
+	{
+		if ( It.Value().IsUnique() )
+		{
+			It.RemoveCurrent();
+		}
+	}
+	for ( auto It = CurveTables.CreateIterator(); It; ++It )
+	{
+		if ( !It.Value().Table.IsValid() || It.Key().ResolveObjectPtr() == nullptr )
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Doubling keeps the sweeps rare however many distinct tables are in use
+	NextTrimAt = Num() * 2;
+}
+
+
+void FBUIEasingTableCache::Empty()
+{
+	Tables.Empty();
+	CustomTables.Empty();
+	CurveTables.Empty();
+	NextTrimAt = 0;
+}
@@ -1,99 +1,35 @@
 #include "BUITween.h"
 
-TArray< FBUITweenInstance > UBUITween::ActiveInstances = TArray< FBUITweenInstance >();
-TArray< FBUITweenInstance > UBUITween::InstancesToAdd = TArray< FBUITweenInstance >();
-bool UBUITween::bIsInitialized = false;
+TUniquePtr< FBUITweenManager > UBUITween::DefaultManager;
 
 void UBUITween::Startup()
 {
-	bIsInitialized = true;
-	ActiveInstances.Empty();
-	InstancesToAdd.Empty();
-}
-
-
-void UBUITween::Shutdown()
-{
-	ActiveInstances.Empty();
-	InstancesToAdd.Empty();
-	bIsInitialized = false;
-}
-
-
-FBUITweenInstance& UBUITween::Create( UWidget* pInWidget, float InDuration, float InDelay, bool bIsAdditive )
-{
-	// By default let's kill any existing tweens
-	if ( !bIsAdditive )
+	// The manager is never replaced, handles hold on to its address
+	if ( !DefaultManager.IsValid() )
 	{
-		Clear( pInWidget );
+		DefaultManager = MakeUnique< FBUITweenManager >();
 	}
-
-	FBUITweenInstance Instance( pInWidget, InDuration, InDelay );
-
-	InstancesToAdd.Add( Instance );
-
-	return InstancesToAdd.Last();
-}
-
-
-int32 UBUITween::Clear( UWidget* pInWidget )
-{
-	int32 NumRemoved = 0;
-
-	auto DoesTweenMatchWidgetFn = [pInWidget](const FBUITweenInstance& CurTweenInstance) -> bool {
-		return ( CurTweenInstance.GetWidget().IsValid() && CurTweenInstance.GetWidget() == pInWidget );
-	};
-
-	NumRemoved += ActiveInstances.RemoveAll(DoesTweenMatchWidgetFn);
-	NumRemoved += InstancesToAdd.RemoveAll(DoesTweenMatchWidgetFn);
-
-	return NumRemoved;
 }
 
 
-void UBUITween::Update( float DeltaTime )
+void UBUITween::Shutdown()
 {
-	// Reverse it so we can remove
-	for ( int32 i = ActiveInstances.Num()-1; i >= 0; --i )
-	{
-		FBUITweenInstance& Inst = ActiveInstances[ i ];
-		Inst.Update( DeltaTime );
-		if ( Inst.IsComplete() )
-		{
-			FBUITweenInstance CompleteInst = Inst;
-			ActiveInstances.RemoveAt( i );
-
-			// We do this here outside of the instance update and after removing from active instances because we
-			// don't know if the callback in the cleanup is going to trigger adding more events
-			CompleteInst.DoCompleteCleanup();
-		}
-	}
-
-	for ( int32 i = 0; i < InstancesToAdd.Num(); ++i )
+	// Emptied rather than destroyed, so handles kept past shutdown go stale instead of dangling
+	if ( DefaultManager.IsValid() )
 	{
-		ActiveInstances.Add( InstancesToAdd[ i ] );
+		DefaultManager->Empty();
 	}
-	InstancesToAdd.Empty();
+	// Tweens in other managers keep the tables they use alive
+	FBUIEasingTableCache::Empty();
 }
 
 
-bool UBUITween::GetIsTweening( UWidget* pInWidget )
+FBUITweenManager& UBUITween::GetDefaultManager()
 {
-	for ( int32 i = 0; i < ActiveInstances.Num(); ++i )
+	// Created on demand as well, so tweens made before the module starts up still have somewhere to go
+	if ( !DefaultManager.IsValid() )
 	{
-		if ( ActiveInstances[ i ].GetWidget() == pInWidget )
-		{
-			return true;
-		}
+		Startup();
 	}
-	return false;
-}
-
-
-void UBUITween::CompleteAll()
-{
-	// Very hacky way to make sure all Tweens complete immediately.
-	// First Update clears ActiveTweens, second clears "InstancesToAdd".
-	Update( 100000 );
-	Update( 100000 );
+	return *DefaultManager;
 }
@@ -0,0 +1,47 @@
+#include "BUITweenHandle.h"
+#include "BUITweenManager.h"
+
+FBUITweenInstance* FBUITweenHandle::Resolve() const
+{
+	return Manager ? Manager->GetInstance( *this ) : nullptr;
+}
+
+
+FBUITweenHandle& FBUITweenHandle::Begin()
+{
+	if ( Manager ) Manager->Begin( *this );
+	return *this;
+}
+
+
+bool FBUITweenHandle::Cancel()
+{
+	return Manager ? Manager->Cancel( *this ) : false;
+}
+
+
+FBUITweenHandle& FBUITweenHandle::Pause()
+{
+	if ( Manager ) Manager->SetPaused( *this, true );
+	return *this;
+}
+
+
+FBUITweenHandle& FBUITweenHandle::Resume()
+{
+	if ( Manager ) Manager->SetPaused( *this, false );
+	return *this;
+}
+
+
+bool FBUITweenHandle::IsPaused() const
+{
+	return Manager ? Manager->IsPaused( *this ) : false;
+}
+
+
+bool FBUITweenHandle::IsComplete() const
+{
+	// Completed tweens are released from the pool, so a stale handle counts as complete
+	return Resolve() == nullptr;
+}
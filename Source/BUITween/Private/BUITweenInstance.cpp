@@ -9,230 +9,785 @@
 #include "Components/HorizontalBoxSlot.h"
 #include "Components/SizeBox.h"
 #include "Blueprint/UserWidget.h"
+#include "Widgets/SWidget.h"
+#include "BUITweenStats.h"
+#include "BUIEasingTable.h"
 
 DEFINE_LOG_CATEGORY(LogBUITween);
 
-void FBUITweenInstance::Begin()
+int32 FBUITweenCallback::NumHeapBindings = 0;
+
+FBUITweenInstance::FBUITweenInstance( TArrayView< UWidget* > Targets, float InTargetDuration, float InInterval, bool bInIsAdditive )
+	: StaggerInterval( FMath::Max( InInterval, 0.0f ) )
+	, StaggerTargetDuration( FMath::Max( InTargetDuration, 0.0f ) )
+	, bIsAdditive( bInIsAdditive )
+{
+	StaggerTargets.SetNum( Targets.Num() );
+	for ( int32 i = 0; i < Targets.Num(); ++i )
+	{
+		ensure( Targets[ i ] != nullptr );
+		StaggerTargets[ i ].Widget = Targets[ i ];
+	}
+}
+
+FBUITweenInstance& FBUITweenInstance::Easing( const UCurveFloat* InCurve )
+{
+	if ( InCurve )
+	{
+		CustomEasing = FBUIEasingTableCache::GetForCurve( *InCurve );
+	}
+	else
+	{
+		CustomEasing.Reset();
+	}
+	return *this;
+}
+
+
+FBUITweenInstance& FBUITweenInstance::EasingBezier( float X1, float Y1, float X2, float Y2 )
+{
+	CustomEasing = FBUIEasingTableCache::GetForBezier( X1, Y1, X2, Y2 );
+	return *this;
+}
+
+
+void FBUITweenInstance::Begin( const FWidgetTransform& BaseTransform, float BaseOpacity )
 {
-	bShouldUpdate = true;
-	bHasPlayedStartEvent = false;
 	bHasPlayedCompleteEvent = false;
+	NumStaggerTargetsFinished = 0;
+
+	// Staggered targets each have their own base, so the manager begins them one by one through BeginTarget
+	if ( !IsStaggered() )
+	{
+		BeginTarget( State, BaseTransform, BaseOpacity );
+	}
+}
 
-	if ( !pWidget.IsValid() )
+void FBUITweenInstance::BeginTarget( FBUITweenTargetState& Target, const FWidgetTransform& BaseTransform, float BaseOpacity ) const
+{
+	UWidget* Widget = Target.Widget.Get();
+	if ( Widget == nullptr )
 	{
 		UE_LOG( LogBUITween, Warning, TEXT( "Trying to start invalid widget" ) );
 		return;
 	}
 
-	// Set all the props to the existng state
-	TranslationProp.OnBegin( pWidget->RenderTransform.Translation );
-	ScaleProp.OnBegin( pWidget->RenderTransform.Scale );
-	RotationProp.OnBegin( pWidget->RenderTransform.Angle );
-	OpacityProp.OnBegin( pWidget->GetRenderOpacity() );
+	FBUITweenSetterBinding& Binding = Target.Binding;
+	ResolveWidgetBinding( Widget, Binding );
+	ResolveSlotBinding( Widget, Binding );
+	Target.bHasAppliedVisibility = false;
 
+	// Set all the props to the existng state. Additive layers start from no change instead.
+	if ( bIsAdditive )
 	{
-		UUserWidget* UW = Cast<UUserWidget>( pWidget );
-		if ( UW )
-		{
-			ColorProp.OnBegin( UW->ColorAndOpacity );
-		}
-		UImage* UI = Cast<UImage>( pWidget );
-		if ( UI )
-		{
-			ColorProp.OnBegin( UI->ColorAndOpacity );
-		}
-		UBorder* Border = Cast<UBorder>( pWidget );
-		if ( Border )
-		{
-			ColorProp.OnBegin( Border->ContentColorAndOpacity );
-		}
+		Target.Translation = TranslationProp.GetStart( FVector2D::ZeroVector );
+		Target.Scale = ScaleProp.GetStart( FVector2D::UnitVector );
+		Target.Rotation = RotationProp.GetStart( 0 );
+		Target.Opacity = OpacityProp.GetStart( 1.0f );
 	}
-
-	VisibilityProp.OnBegin( pWidget->GetVisibility() );
-
-	UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>( pWidget->Slot );
-	if ( CanvasSlot )
+	else
 	{
-		CanvasPositionProp.OnBegin( CanvasSlot->GetPosition() );
+		Target.Translation = TranslationProp.GetStart( BaseTransform.Translation );
+		Target.Scale = ScaleProp.GetStart( BaseTransform.Scale );
+		Target.Rotation = RotationProp.GetStart( BaseTransform.Angle );
+		Target.Opacity = OpacityProp.GetStart( BaseOpacity );
 	}
-	UOverlaySlot* OverlaySlot = Cast<UOverlaySlot>( pWidget->Slot );
-	UHorizontalBoxSlot* HorizontalBoxSlot = Cast<UHorizontalBoxSlot>( pWidget->Slot );
-	UVerticalBoxSlot* VerticalBoxSlot = Cast<UVerticalBoxSlot>( pWidget->Slot );
-	if ( OverlaySlot )
+
+	switch ( Binding.ColorTarget )
 	{
-		PaddingProp.OnBegin( FVector4(
-			OverlaySlot->Padding.Left,
-			OverlaySlot->Padding.Top,
-			OverlaySlot->Padding.Bottom,
-			OverlaySlot->Padding.Right ) );
+		case EBUITweenColorTarget::UserWidget:
+			Target.Color = ColorProp.GetStart( static_cast<UUserWidget*>( Widget )->ColorAndOpacity );
+			break;
+		case EBUITweenColorTarget::Image:
+			Target.Color = ColorProp.GetStart( static_cast<UImage*>( Widget )->ColorAndOpacity );
+			break;
+		case EBUITweenColorTarget::Border:
+			Target.Color = ColorProp.GetStart( static_cast<UBorder*>( Widget )->ContentColorAndOpacity );
+			break;
+		default:
+			Target.Color = ColorProp.GetStart( FLinearColor::White );
+			break;
 	}
-	else if ( HorizontalBoxSlot )
+
+	Target.Visibility = VisibilityProp.GetStart( Widget->GetVisibility() );
+
+	const FMargin* SlotPadding = nullptr;
+	switch ( Binding.SlotTarget )
 	{
-		PaddingProp.OnBegin( FVector4(
-			HorizontalBoxSlot->Padding.Left,
-			HorizontalBoxSlot->Padding.Top,
-			HorizontalBoxSlot->Padding.Bottom,
-			HorizontalBoxSlot->Padding.Right ) );
+		case EBUITweenSlotTarget::CanvasPanel:
+			Target.CanvasPosition = CanvasPositionProp.GetStart( static_cast<UCanvasPanelSlot*>( Binding.Slot )->GetPosition() );
+			break;
+		case EBUITweenSlotTarget::Overlay:
+			SlotPadding = &static_cast<UOverlaySlot*>( Binding.Slot )->Padding;
+			break;
+		case EBUITweenSlotTarget::HorizontalBox:
+			SlotPadding = &static_cast<UHorizontalBoxSlot*>( Binding.Slot )->Padding;
+			break;
+		case EBUITweenSlotTarget::VerticalBox:
+			SlotPadding = &static_cast<UVerticalBoxSlot*>( Binding.Slot )->Padding;
+			break;
+		default:
+			break;
 	}
-	else if ( VerticalBoxSlot )
+	if ( SlotPadding )
 	{
-		PaddingProp.OnBegin( FVector4(
-			VerticalBoxSlot->Padding.Left,
-			VerticalBoxSlot->Padding.Top,
-			VerticalBoxSlot->Padding.Bottom,
-			VerticalBoxSlot->Padding.Right ) );
+		// Same component order as ToPadding/FromPadding and FMargin( FVector4 )
+		Target.Padding = PaddingProp.GetStart( FVector4( SlotPadding->Left, SlotPadding->Top, SlotPadding->Right, SlotPadding->Bottom ) );
 	}
 
-	USizeBox* SizeBox = Cast<USizeBox>( pWidget );
-	if ( SizeBox )
+	if ( Binding.bIsSizeBox )
 	{
-		MaxDesiredHeightProp.OnBegin( SizeBox->MaxDesiredHeight );
+		Target.MaxDesiredHeight = MaxDesiredHeightProp.GetStart( static_cast<USizeBox*>( Widget )->MaxDesiredHeight );
 	}
 
-	// Apply the starting conditions, even if we delay
-	Apply( 0 );
+	Binding.bEmulateLayout = bEmulateLayout && CanEmulateLayout( Target );
+	Target.bHasEmulatedLayout = false;
+
+	// UBUITween applies the starting conditions straight after this, even if we delay
 }
 
-void FBUITweenInstance::Update( float DeltaTime )
+void FBUITweenInstance::ResolveWidgetBinding( UWidget* Target, FBUITweenSetterBinding& Binding )
 {
-	if ( !bShouldUpdate && !bIsComplete )
+	// A widget is at most one of these, so the first hit wins
+	Binding.ColorTarget = EBUITweenColorTarget::None;
+	if ( Target->IsA<UUserWidget>() )
 	{
-		return;
+		Binding.ColorTarget = EBUITweenColorTarget::UserWidget;
 	}
-	if ( !pWidget.IsValid() )
+	else if ( Target->IsA<UImage>() )
 	{
-		bIsComplete = true;
-		return;
+		Binding.ColorTarget = EBUITweenColorTarget::Image;
+	}
+	else if ( Target->IsA<UBorder>() )
+	{
+		Binding.ColorTarget = EBUITweenColorTarget::Border;
 	}
 
-	if ( Delay > 0 )
+	Binding.bIsSizeBox = Target->IsA<USizeBox>();
+}
+
+void FBUITweenInstance::ResolveSlotBinding( UWidget* Target, FBUITweenSetterBinding& Binding )
+{
+	Binding.Slot = Target->Slot;
+	Binding.SlotTarget = EBUITweenSlotTarget::None;
+	// Only decided at Begin, a widget moved to another slot mid-tween goes back to the setters
+	Binding.bEmulateLayout = false;
+	if ( Binding.Slot == nullptr )
 	{
-		// TODO could correctly subtract from deltatime and use rmaining on alpha but meh
-		Delay -= DeltaTime;
 		return;
 	}
 
-	if ( !bHasPlayedStartEvent )
+	if ( Binding.Slot->IsA<UCanvasPanelSlot>() )
+	{
+		Binding.SlotTarget = EBUITweenSlotTarget::CanvasPanel;
+	}
+	else if ( Binding.Slot->IsA<UOverlaySlot>() )
+	{
+		Binding.SlotTarget = EBUITweenSlotTarget::Overlay;
+	}
+	else if ( Binding.Slot->IsA<UHorizontalBoxSlot>() )
 	{
-		OnStartedDelegate.ExecuteIfBound( pWidget.Get() );
-		bHasPlayedStartEvent = true;
+		Binding.SlotTarget = EBUITweenSlotTarget::HorizontalBox;
 	}
+	else if ( Binding.Slot->IsA<UVerticalBoxSlot>() )
+	{
+		Binding.SlotTarget = EBUITweenSlotTarget::VerticalBox;
+	}
+}
 
-	// Tween each thingy
-	Alpha += DeltaTime;
-	if ( Alpha >= Duration )
+bool FBUITweenInstance::CanEmulateLayout( const FBUITweenTargetState& Target ) const
+{
+	const FBUITweenSetterBinding& Binding = Target.Binding;
+	if ( CanvasPositionProp.IsSet() && Binding.SlotTarget == EBUITweenSlotTarget::CanvasPanel )
 	{
-		Alpha = Duration;
-		bIsComplete = true;
+		// With stretched anchors the position is a margin, moving it resizes the widget
+		const FAnchors Anchors = static_cast<UCanvasPanelSlot*>( Binding.Slot )->GetAnchors();
+		return !Anchors.IsStretchedHorizontal() && !Anchors.IsStretchedVertical();
+	}
+	if ( !PaddingProp.IsSet() )
+	{
+		return false;
 	}
 
-	const float EasedAlpha = EasingParam.IsSet()
-		? FBUIEasing::Ease( EasingType, Alpha, Duration, EasingParam.GetValue() )
-		: FBUIEasing::Ease( EasingType, Alpha, Duration );
+	EHorizontalAlignment HAlign = HAlign_Fill;
+	EVerticalAlignment VAlign = VAlign_Fill;
+	bool bAutoWidth = false;
+	bool bAutoHeight = false;
+	switch ( Binding.SlotTarget )
+	{
+		case EBUITweenSlotTarget::Overlay:
+		{
+			const UOverlaySlot* OverlaySlot = static_cast<UOverlaySlot*>( Binding.Slot );
+			HAlign = OverlaySlot->HorizontalAlignment;
+			VAlign = OverlaySlot->VerticalAlignment;
+			break;
+		}
+		case EBUITweenSlotTarget::HorizontalBox:
+		{
+			const UHorizontalBoxSlot* BoxSlot = static_cast<UHorizontalBoxSlot*>( Binding.Slot );
+			HAlign = BoxSlot->HorizontalAlignment;
+			VAlign = BoxSlot->VerticalAlignment;
+			bAutoWidth = BoxSlot->Size.SizeRule == ESlateSizeRule::Automatic;
+			break;
+		}
+		case EBUITweenSlotTarget::VerticalBox:
+		{
+			const UVerticalBoxSlot* BoxSlot = static_cast<UVerticalBoxSlot*>( Binding.Slot );
+			HAlign = BoxSlot->HorizontalAlignment;
+			VAlign = BoxSlot->VerticalAlignment;
+			bAutoHeight = BoxSlot->Size.SizeRule == ESlateSizeRule::Automatic;
+			break;
+		}
+		default:
+			return false;
+	}
 
-	Apply( EasedAlpha );
+	// Filled content takes whatever the padding leaves, so it can only be emulated if the padding on that
+	// axis adds up to the same total at both ends and the content keeps its size
+	const FVector4 Start = Target.Padding;
+	const FVector4 End = PaddingProp.bHasTarget ? PaddingProp.TargetValue : Start;
+	const bool bWidthKept = bAutoWidth || HAlign != HAlign_Fill || FMath::IsNearlyEqual( Start.X + Start.Z, End.X + End.Z );
+	const bool bHeightKept = bAutoHeight || VAlign != VAlign_Fill || FMath::IsNearlyEqual( Start.Y + Start.W, End.Y + End.W );
+	return bWidthKept && bHeightKept;
 }
 
-void FBUITweenInstance::Apply( float EasedAlpha )
+FVector2D FBUITweenInstance::GetPaddingShift( const FBUITweenSetterBinding& Binding, const FVector4& To )
 {
-	UWidget* Target = pWidget.Get();
+	FMargin From;
+	EHorizontalAlignment HAlign = HAlign_Left;
+	EVerticalAlignment VAlign = VAlign_Top;
+	bool bAutoWidth = false;
+	bool bAutoHeight = false;
+	switch ( Binding.SlotTarget )
+	{
+		case EBUITweenSlotTarget::Overlay:
+		{
+			const UOverlaySlot* OverlaySlot = static_cast<UOverlaySlot*>( Binding.Slot );
+			From = OverlaySlot->Padding;
+			HAlign = OverlaySlot->HorizontalAlignment;
+			VAlign = OverlaySlot->VerticalAlignment;
+			break;
+		}
+		case EBUITweenSlotTarget::HorizontalBox:
+		{
+			const UHorizontalBoxSlot* BoxSlot = static_cast<UHorizontalBoxSlot*>( Binding.Slot );
+			From = BoxSlot->Padding;
+			HAlign = BoxSlot->HorizontalAlignment;
+			VAlign = BoxSlot->VerticalAlignment;
+			bAutoWidth = BoxSlot->Size.SizeRule == ESlateSizeRule::Automatic;
+			break;
+		}
+		case EBUITweenSlotTarget::VerticalBox:
+		{
+			const UVerticalBoxSlot* BoxSlot = static_cast<UVerticalBoxSlot*>( Binding.Slot );
+			From = BoxSlot->Padding;
+			HAlign = BoxSlot->HorizontalAlignment;
+			VAlign = BoxSlot->VerticalAlignment;
+			bAutoHeight = BoxSlot->Size.SizeRule == ESlateSizeRule::Automatic;
+			break;
+		}
+		default:
+			return FVector2D::ZeroVector;
+	}
 
-	if ( ColorProp.IsSet() )
+	// Content sits against the near edge, the far edge, or halfway between for centred and filled content.
+	// Along a box's own axis an auto-sized slot always starts its content after the near padding.
+	auto Shift = []( float NearDelta, float FarDelta, bool bNear, bool bFar )
+	{
+		return bNear ? NearDelta : ( bFar ? -FarDelta : ( NearDelta - FarDelta ) * 0.5f );
+	};
+	return FVector2D(
+		Shift( To.X - From.Left, To.Z - From.Right, bAutoWidth || HAlign == HAlign_Left, !bAutoWidth && HAlign == HAlign_Right ),
+		Shift( To.Y - From.Top, To.W - From.Bottom, bAutoHeight || VAlign == VAlign_Top, !bAutoHeight && VAlign == VAlign_Bottom ) );
+}
+
+namespace BUITweenWrites
+{
+	// True if the setter has to be called. bExact drops the tolerance so the last frame lands on the target.
+	inline bool NeedsWrite( float Current, float New, float Tolerance, bool bExact )
+	{
+		return bExact ? Current != New : FMath::Abs( Current - New ) > Tolerance;
+	}
+	inline bool NeedsWrite( const FVector2D& Current, const FVector2D& New, float Tolerance, bool bExact )
+	{
+		return bExact ? Current != New : !Current.Equals( New, Tolerance );
+	}
+	inline bool NeedsWrite( const FLinearColor& Current, const FLinearColor& New, float Tolerance, bool bExact )
+	{
+		return bExact ? Current != New : !Current.Equals( New, Tolerance );
+	}
+	inline bool NeedsWrite( const FMargin& Current, const FVector4& New, float Tolerance, bool bExact )
+	{
+		return NeedsWrite( Current.Left, New.X, Tolerance, bExact )
+			|| NeedsWrite( Current.Top, New.Y, Tolerance, bExact )
+			|| NeedsWrite( Current.Right, New.Z, Tolerance, bExact )
+			|| NeedsWrite( Current.Bottom, New.W, Tolerance, bExact );
+	}
+	inline bool NeedsWrite( const FWidgetTransform& Current, const FWidgetTransform& New, bool bExact )
+	{
+		return NeedsWrite( Current.Translation, New.Translation, FBUITweenWidgetWrites::TranslationTolerance, bExact )
+			|| NeedsWrite( Current.Scale, New.Scale, FBUITweenWidgetWrites::ScaleTolerance, bExact )
+			|| NeedsWrite( Current.Shear, New.Shear, FBUITweenWidgetWrites::ScaleTolerance, bExact )
+			|| NeedsWrite( Current.Angle, New.Angle, FBUITweenWidgetWrites::AngleTolerance, bExact );
+	}
+
+	// Bumps the matching counter and passes bNeedsWrite through
+	inline bool Count( bool bNeedsWrite, FBUITweenWriteCounters& Counters )
 	{
-		ColorProp.Update( EasedAlpha );
-		UUserWidget* UW = Cast<UUserWidget>( Target );
-		if ( UW )
+		if ( bNeedsWrite )
 		{
-			UW->SetColorAndOpacity( ColorProp.CurrentValue );
+			Counters.Issued++;
 		}
-		UImage* UI = Cast<UImage>( Target );
-		if ( UI )
+		else
 		{
-			UI->SetColorAndOpacity( ColorProp.CurrentValue );
+			Counters.Skipped++;
 		}
-		UBorder* Border = Cast<UBorder>( Target );
-		if ( Border )
+		return bNeedsWrite;
+	}
+}
+
+void FBUITweenInstance::Apply( float EasedAlpha, bool bIsFinal, FBUITweenWidgetWrites& Writes, FBUITweenWriteCounters& Counters )
+{
+	ApplyTarget( State, EasedAlpha, bIsFinal, Writes, Counters );
+}
+
+void FBUITweenInstance::ApplyTarget( FBUITweenTargetState& TargetState, float EasedAlpha, bool bIsFinal, FBUITweenWidgetWrites& Writes, FBUITweenWriteCounters& Counters ) const
+{
+	FBUITweenValues Values;
+	EvaluateTarget( TargetState, EasedAlpha, Values );
+	ApplyTargetValues( TargetState, Values, bIsFinal, Writes, Counters );
+}
+
+void FBUITweenInstance::EvaluateTarget( const FBUITweenTargetState& Target, float EasedAlpha, FBUITweenValues& OutValues ) const
+{
+	if ( TranslationProp.IsSet() )
+	{
+		OutValues.Translation = TranslationProp.Evaluate( Target.Translation, EasedAlpha );
+	}
+	if ( ScaleProp.IsSet() )
+	{
+		OutValues.Scale = ScaleProp.Evaluate( Target.Scale, EasedAlpha );
+	}
+	if ( ColorProp.IsSet() )
+	{
+		OutValues.Color = ColorProp.Evaluate( Target.Color, EasedAlpha );
+	}
+	if ( OpacityProp.IsSet() )
+	{
+		OutValues.Opacity = OpacityProp.Evaluate( Target.Opacity, EasedAlpha );
+	}
+	if ( RotationProp.IsSet() )
+	{
+		OutValues.Rotation = RotationProp.Evaluate( Target.Rotation, EasedAlpha );
+	}
+	if ( CanvasPositionProp.IsSet() )
+	{
+		OutValues.CanvasPosition = CanvasPositionProp.Evaluate( Target.CanvasPosition, EasedAlpha );
+	}
+	if ( PaddingProp.IsSet() )
+	{
+		OutValues.Padding = PaddingProp.Evaluate( Target.Padding, EasedAlpha );
+	}
+	if ( MaxDesiredHeightProp.IsSet() )
+	{
+		OutValues.MaxDesiredHeight = MaxDesiredHeightProp.Evaluate( Target.MaxDesiredHeight, EasedAlpha );
+	}
+	if ( VisibilityProp.IsSet() )
+	{
+		OutValues.Visibility = VisibilityProp.Evaluate( Target.Visibility, EasedAlpha );
+	}
+}
+
+void FBUITweenInstance::ApplyTargetValues( FBUITweenTargetState& TargetState, const FBUITweenValues& Values, bool bIsFinal, FBUITweenWidgetWrites& Writes, FBUITweenWriteCounters& Counters ) const
+{
+	using namespace BUITweenWrites;
+
+	UWidget* Target = TargetState.Widget.Get();
+	FBUITweenSetterBinding& Binding = TargetState.Binding;
+	Writes.bExact |= bIsFinal;
+
+	// The slot pointer is only trusted while the widget still sits in it, rebind if it was moved since Begin
+	if ( Target->Slot != Binding.Slot )
+	{
+		ResolveSlotBinding( Target, Binding );
+	}
+
+	// Everything is compared against what the widget currently holds rather than what we wrote last, so
+	// small steps can't accumulate into a visible drift and changes made by other code are noticed
+	if ( ColorProp.IsSet() )
+	{
+		BUITWEEN_SCOPE_CYCLE_COUNTER( STAT_BUITweenApplyColor );
+		const FLinearColor& Color = Values.Color;
+		switch ( Binding.ColorTarget )
 		{
-			Border->SetContentColorAndOpacity( ColorProp.CurrentValue );
+			case EBUITweenColorTarget::UserWidget:
+			{
+				UUserWidget* UserWidget = static_cast<UUserWidget*>( Target );
+				if ( Count( NeedsWrite( UserWidget->ColorAndOpacity, Color, FBUITweenWidgetWrites::ColorTolerance, bIsFinal ), Counters ) )
+				{
+					UserWidget->SetColorAndOpacity( Color );
+				}
+				break;
+			}
+			case EBUITweenColorTarget::Image:
+			{
+				UImage* Image = static_cast<UImage*>( Target );
+				if ( Count( NeedsWrite( Image->ColorAndOpacity, Color, FBUITweenWidgetWrites::ColorTolerance, bIsFinal ), Counters ) )
+				{
+					Image->SetColorAndOpacity( Color );
+				}
+				break;
+			}
+			case EBUITweenColorTarget::Border:
+			{
+				UBorder* Border = static_cast<UBorder*>( Target );
+				if ( Count( NeedsWrite( Border->ContentColorAndOpacity, Color, FBUITweenWidgetWrites::ColorTolerance, bIsFinal ), Counters ) )
+				{
+					Border->SetContentColorAndOpacity( Color );
+				}
+				break;
+			}
+			default:
+				break;
 		}
 	}
 
+	// Additive tweens accumulate into a layer, everything else replaces the base value
+	FBUITweenLayerBlend* Layer = bIsAdditive ? ( bIsFinal ? &Writes.Settled : &Writes.Live ) : nullptr;
+
 	if ( OpacityProp.IsSet() )
 	{
-		OpacityProp.Update( EasedAlpha );
-		Target->SetRenderOpacity( OpacityProp.CurrentValue );
+		const float Opacity = Values.Opacity;
+		if ( Layer )
+		{
+			Layer->Opacity *= Opacity;
+			Layer->Channels |= EBUITweenWriteChannels::Opacity;
+		}
+		else
+		{
+			Writes.Opacity = Opacity;
+			Writes.Channels |= EBUITweenWriteChannels::Opacity;
+		}
 	}
 
 	// Only apply visibility changes at 0 or 1
 	if ( VisibilityProp.IsSet() )
 	{
-		if ( VisibilityProp.Update( EasedAlpha ) )
+		BUITWEEN_SCOPE_CYCLE_COUNTER( STAT_BUITweenApplyVisibility );
+		const ESlateVisibility Visibility = Values.Visibility;
+		if ( !TargetState.bHasAppliedVisibility || TargetState.AppliedVisibility != Visibility )
 		{
-			Target->SetVisibility( VisibilityProp.CurrentValue );
+			TargetState.AppliedVisibility = Visibility;
+			TargetState.bHasAppliedVisibility = true;
+			if ( Count( Target->GetVisibility() != Visibility, Counters ) )
+			{
+				Target->SetVisibility( Visibility );
+			}
 		}
 	}
 
-	bool bChangedRenderTransform = false;
-	FWidgetTransform CurrentTransform = Target->RenderTransform;
-
 	if ( TranslationProp.IsSet() )
 	{
-		TranslationProp.Update( EasedAlpha );
-		CurrentTransform.Translation = TranslationProp.CurrentValue;
-		bChangedRenderTransform = true;
+		const FVector2D& Translation = Values.Translation;
+		if ( Layer )
+		{
+			Layer->Translation += Translation;
+			Layer->Channels |= EBUITweenWriteChannels::Translation;
+		}
+		else
+		{
+			Writes.Translation = Translation;
+			Writes.Channels |= EBUITweenWriteChannels::Translation;
+		}
 	}
 	if ( ScaleProp.IsSet() )
 	{
-		ScaleProp.Update( EasedAlpha );
-		CurrentTransform.Scale = ScaleProp.CurrentValue;
-		bChangedRenderTransform = true;
+		const FVector2D& Scale = Values.Scale;
+		if ( Layer )
+		{
+			Layer->Scale *= Scale;
+			Layer->Channels |= EBUITweenWriteChannels::Scale;
+		}
+		else
+		{
+			Writes.Scale = Scale;
+			Writes.Channels |= EBUITweenWriteChannels::Scale;
+		}
 	}
 	if ( RotationProp.IsSet() )
 	{
-		if ( RotationProp.Update( EasedAlpha ) )
+		const float Angle = Values.Rotation;
+		if ( Layer )
 		{
-			CurrentTransform.Angle = RotationProp.CurrentValue;
-			bChangedRenderTransform = true;
+			Layer->Angle += Angle;
+			Layer->Channels |= EBUITweenWriteChannels::Angle;
 		}
-	}
-	if ( CanvasPositionProp.IsSet() )
-	{
-		if ( CanvasPositionProp.Update( EasedAlpha ) )
+		else
 		{
-			UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>( pWidget->Slot );
-			if ( CanvasSlot )
-				CanvasSlot->SetPosition( CanvasPositionProp.CurrentValue );
+			Writes.Angle = Angle;
+			Writes.Channels |= EBUITweenWriteChannels::Angle;
 		}
 	}
-	if ( PaddingProp.IsSet() )
+
+	// Emulated layout tracks show as an offset from where the slot still is, the slot is written on the last
+	// frame. The offset is a live layer, so it is never folded into the widget's base transform.
+	const bool bEmulating = Binding.bEmulateLayout && !bIsFinal;
+	if ( bEmulating || TargetState.bHasEmulatedLayout )
 	{
-		if ( PaddingProp.Update( EasedAlpha ) )
+		// Also flagged on the frame the offset goes away, so the transform is rewritten without it
+		Writes.Live.Channels |= EBUITweenWriteChannels::Translation;
+		TargetState.bHasEmulatedLayout = bEmulating;
+	}
+
+	if ( CanvasPositionProp.IsSet() && Binding.SlotTarget == EBUITweenSlotTarget::CanvasPanel )
+	{
+		BUITWEEN_SCOPE_CYCLE_COUNTER( STAT_BUITweenApplyLayout );
+		const FVector2D& Position = Values.CanvasPosition;
+		UCanvasPanelSlot* CanvasSlot = static_cast<UCanvasPanelSlot*>( Binding.Slot );
+		if ( bEmulating )
+		{
+			Writes.Live.Translation += Position - CanvasSlot->GetPosition();
+			TargetState.EmulatedLayout = FVector4( Position.X, Position.Y, 0, 0 );
+		}
+		else if ( Count( NeedsWrite( CanvasSlot->GetPosition(), Position, FBUITweenWidgetWrites::LayoutTolerance, bIsFinal ), Counters ) )
 		{
-			UOverlaySlot* OverlaySlot = Cast<UOverlaySlot>( pWidget->Slot );
-			UHorizontalBoxSlot* HorizontalBoxSlot = Cast<UHorizontalBoxSlot>( pWidget->Slot );
-			UVerticalBoxSlot* VerticalBoxSlot = Cast<UVerticalBoxSlot>( pWidget->Slot );
-			if ( OverlaySlot )
-				OverlaySlot->SetPadding( PaddingProp.CurrentValue );
-			else if ( HorizontalBoxSlot )
-				HorizontalBoxSlot->SetPadding( PaddingProp.CurrentValue );
-			else if ( VerticalBoxSlot )
-				VerticalBoxSlot->SetPadding( PaddingProp.CurrentValue );
+			CanvasSlot->SetPosition( Position );
 		}
 	}
-	if ( MaxDesiredHeightProp.IsSet() )
+	if ( PaddingProp.IsSet() && bEmulating )
 	{
-		if ( MaxDesiredHeightProp.Update( EasedAlpha ) )
+		Writes.Live.Translation += GetPaddingShift( Binding, Values.Padding );
+		TargetState.EmulatedLayout = Values.Padding;
+	}
+	else if ( PaddingProp.IsSet() )
+	{
+		BUITWEEN_SCOPE_CYCLE_COUNTER( STAT_BUITweenApplyLayout );
+		const FVector4& PaddingValue = Values.Padding;
+		const FMargin Padding( PaddingValue );
+		switch ( Binding.SlotTarget )
 		{
-			USizeBox* SizeBox = Cast<USizeBox>( pWidget );
-			if ( SizeBox )
+			case EBUITweenSlotTarget::Overlay:
+			{
+				UOverlaySlot* OverlaySlot = static_cast<UOverlaySlot*>( Binding.Slot );
+				if ( Count( NeedsWrite( OverlaySlot->Padding, PaddingValue, FBUITweenWidgetWrites::LayoutTolerance, bIsFinal ), Counters ) )
+				{
+					OverlaySlot->SetPadding( Padding );
+				}
+				break;
+			}
+			case EBUITweenSlotTarget::HorizontalBox:
+			{
+				UHorizontalBoxSlot* BoxSlot = static_cast<UHorizontalBoxSlot*>( Binding.Slot );
+				if ( Count( NeedsWrite( BoxSlot->Padding, PaddingValue, FBUITweenWidgetWrites::LayoutTolerance, bIsFinal ), Counters ) )
+				{
+					BoxSlot->SetPadding( Padding );
+				}
+				break;
+			}
+			case EBUITweenSlotTarget::VerticalBox:
 			{
-				SizeBox->SetMaxDesiredHeight( MaxDesiredHeightProp.CurrentValue );
+				UVerticalBoxSlot* BoxSlot = static_cast<UVerticalBoxSlot*>( Binding.Slot );
+				if ( Count( NeedsWrite( BoxSlot->Padding, PaddingValue, FBUITweenWidgetWrites::LayoutTolerance, bIsFinal ), Counters ) )
+				{
+					BoxSlot->SetPadding( Padding );
+				}
+				break;
 			}
+			default:
+				break;
+		}
+	}
+	if ( MaxDesiredHeightProp.IsSet() && Binding.bIsSizeBox )
+	{
+		BUITWEEN_SCOPE_CYCLE_COUNTER( STAT_BUITweenApplyLayout );
+		const float MaxDesiredHeight = Values.MaxDesiredHeight;
+		USizeBox* SizeBox = static_cast<USizeBox*>( Target );
+		if ( Count( NeedsWrite( SizeBox->MaxDesiredHeight, MaxDesiredHeight, FBUITweenWidgetWrites::LayoutTolerance, bIsFinal ), Counters ) )
+		{
+			SizeBox->SetMaxDesiredHeight( MaxDesiredHeight );
 		}
 	}
+}
 
-	if ( bChangedRenderTransform )
+void FBUITweenInstance::CommitEmulatedLayout( FBUITweenTargetState& TargetState, FBUITweenWidgetWrites& Writes, FBUITweenWriteCounters& Counters ) const
+{
+	if ( !TargetState.bHasEmulatedLayout )
 	{
-		Target->SetRenderTransform( CurrentTransform );
+		return;
 	}
+	TargetState.bHasEmulatedLayout = false;
+	Writes.Live.Channels |= EBUITweenWriteChannels::Translation;
+
+	// Written as if it were the last frame, the tracks not being emulated are left as they are
+	const FVector4& Value = TargetState.EmulatedLayout;
+	const FBUITweenSetterBinding& Binding = TargetState.Binding;
+	BUITWEEN_SCOPE_CYCLE_COUNTER( STAT_BUITweenApplyLayout );
+	switch ( Binding.SlotTarget )
+	{
+		case EBUITweenSlotTarget::CanvasPanel:
+			Counters.Issued++;
+			static_cast<UCanvasPanelSlot*>( Binding.Slot )->SetPosition( FVector2D( Value.X, Value.Y ) );
+			break;
+		case EBUITweenSlotTarget::Overlay:
+			Counters.Issued++;
+			static_cast<UOverlaySlot*>( Binding.Slot )->SetPadding( FMargin( Value ) );
+			break;
+		case EBUITweenSlotTarget::HorizontalBox:
+			Counters.Issued++;
+			static_cast<UHorizontalBoxSlot*>( Binding.Slot )->SetPadding( FMargin( Value ) );
+			break;
+		case EBUITweenSlotTarget::VerticalBox:
+			Counters.Issued++;
+			static_cast<UVerticalBoxSlot*>( Binding.Slot )->SetPadding( FMargin( Value ) );
+			break;
+		default:
+			break;
+	}
+}
+
+void FBUITweenWidgetBase::Get( const UWidget* Target, FWidgetTransform& OutTransform, float& OutOpacity ) const
+{
+	using namespace BUITweenWrites;
+
+	FWidgetTransform DisplayedTransform;
+	float DisplayedOpacity;
+	GetDisplayed( Target, DisplayedTransform, DisplayedOpacity );
+
+	const bool bTransformUntouched = bIsValid && !NeedsWrite( DisplayedTransform, WrittenTransform, true );
+	OutTransform = bTransformUntouched ? Transform : DisplayedTransform;
+
+	const bool bOpacityUntouched = bIsValid && DisplayedOpacity == WrittenOpacity;
+	OutOpacity = bOpacityUntouched ? Opacity : DisplayedOpacity;
+}
+
+void FBUITweenWidgetBase::GetDisplayed( const UWidget* Target, FWidgetTransform& OutTransform, float& OutOpacity ) const
+{
+	using namespace BUITweenWrites;
+
+	const bool bTransformStale = bIsUMGStale && !NeedsWrite( Target->RenderTransform, UMGTransform, true );
+	OutTransform = bTransformStale ? WrittenTransform : Target->RenderTransform;
+
+	const bool bOpacityStale = bIsUMGStale && Target->GetRenderOpacity() == UMGOpacity;
+	OutOpacity = bOpacityStale ? WrittenOpacity : Target->GetRenderOpacity();
+}
+
+void FBUITweenWidgetBase::SyncUMG( UWidget* Target )
+{
+	using namespace BUITweenWrites;
+
+	if ( !bIsUMGStale || Target == nullptr )
+	{
+		bIsUMGStale = false;
+		return;
+	}
+	bIsUMGStale = false;
+
+	// Slate already holds these, so the UMG setters only store them and don't invalidate again
+	if ( !NeedsWrite( Target->RenderTransform, UMGTransform, true ) )
+	{
+		Target->SetRenderTransform( WrittenTransform );
+	}
+	if ( Target->GetRenderOpacity() == UMGOpacity )
+	{
+		Target->SetRenderOpacity( WrittenOpacity );
+	}
+}
+
+void FBUITweenWidgetWrites::Flush( FBUITweenWidgetBase& Base, FBUITweenWriteCounters& Counters, bool bWriteSlate )
+{
+	using namespace BUITweenWrites;
+
+	UWidget* Target = Widget.Get();
+	if ( Target == nullptr )
+	{
+		return;
+	}
+
+	// Before the SWidget is built there is nothing to write ahead of, the UMG setters keep the values for it
+	const TSharedPtr<SWidget> SlateWidget = bWriteSlate ? Target->GetCachedWidget() : nullptr;
+	if ( !SlateWidget.IsValid() )
+	{
+		Base.SyncUMG( Target );
+	}
+
+	FWidgetTransform BaseTransform;
+	float BaseOpacity;
+	Base.Get( Target, BaseTransform, BaseOpacity );
+
+	// Regular tweens set the base outright
+	if ( EnumHasAnyFlags( Channels, EBUITweenWriteChannels::Translation ) )
+	{
+		BaseTransform.Translation = Translation;
+	}
+	if ( EnumHasAnyFlags( Channels, EBUITweenWriteChannels::Scale ) )
+	{
+		BaseTransform.Scale = Scale;
+	}
+	if ( EnumHasAnyFlags( Channels, EBUITweenWriteChannels::Angle ) )
+	{
+		BaseTransform.Angle = Angle;
+	}
+	if ( EnumHasAnyFlags( Channels, EBUITweenWriteChannels::Opacity ) )
+	{
+		BaseOpacity = Opacity;
+	}
+
+	// Finished layers become part of the base
+	BaseTransform.Translation += Settled.Translation;
+	BaseTransform.Scale *= Settled.Scale;
+	BaseTransform.Angle += Settled.Angle;
+	BaseOpacity *= Settled.Opacity;
+
+	// Running layers only show on the widget
+	FWidgetTransform Transform = BaseTransform;
+	Transform.Translation += Live.Translation;
+	Transform.Scale *= Live.Scale;
+	Transform.Angle += Live.Angle;
+	const float FinalOpacity = BaseOpacity * Live.Opacity;
+
+	const EBUITweenWriteChannels Touched = Channels | Live.Channels | Settled.Channels;
+	const EBUITweenWriteChannels TransformChannels = EBUITweenWriteChannels::Translation | EBUITweenWriteChannels::Scale | EBUITweenWriteChannels::Angle;
+
+	// What the widget holds after this flush, which may be a skipped write's tolerance away from Transform
+	FWidgetTransform WrittenTransform;
+	float WrittenOpacity;
+	Base.GetDisplayed( Target, WrittenTransform, WrittenOpacity );
+
+	const bool bWriteTransform = EnumHasAnyFlags( Touched, TransformChannels ) && Count( NeedsWrite( WrittenTransform, Transform, bExact ), Counters );
+	const bool bWriteOpacity = EnumHasAnyFlags( Touched, EBUITweenWriteChannels::Opacity ) && Count( NeedsWrite( WrittenOpacity, FinalOpacity, OpacityTolerance, bExact ), Counters );
+
+	if ( SlateWidget.IsValid() )
+	{
+		// Straight to Slate, the same calls UWidget::SetRenderTransform and SetRenderOpacity end in, without
+		// touching the UMG properties. SWidget::SetRenderOpacity only invalidates paint.
+		if ( bWriteTransform )
+		{
+			SlateWidget->SetRenderTransform( Transform.IsIdentity() ? TOptional<FSlateRenderTransform>() : TOptional<FSlateRenderTransform>( Transform.ToSlateRenderTransform() ) );
+		}
+		if ( bWriteOpacity )
+		{
+			SlateWidget->SetRenderOpacity( FinalOpacity );
+		}
+		// Tracks the UMG values every frame, so one set through UMG mid-tween is noticed by GetDisplayed once
+		Base.UMGTransform = Target->RenderTransform;
+		Base.UMGOpacity = Target->GetRenderOpacity();
+		Base.bIsUMGStale = true;
+	}
+	else
+	{
+		if ( bWriteTransform )
+		{
+			Target->SetRenderTransform( Transform );
+		}
+		if ( bWriteOpacity )
+		{
+			Target->SetRenderOpacity( FinalOpacity );
+		}
+	}
+
+	Base.Transform = BaseTransform;
+	Base.Opacity = BaseOpacity;
+	Base.WrittenTransform = bWriteTransform ? Transform : WrittenTransform;
+	Base.WrittenOpacity = bWriteOpacity ? FinalOpacity : WrittenOpacity;
+	Base.bIsValid = true;
 }
@@ -0,0 +1,1704 @@
+#include "BUITweenManager.h"
+#include "BUITweenSettings.h"
+#include "BUITweenStats.h"
+#include "Async/ParallelFor.h"
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/PanelWidget.h"
+#include "Components/ScrollBox.h"
+
+namespace BUITweenCulling
+{
+	// Whether the widget itself can be on screen within its parent: it is visible and isn't scrolled out of
+	// a scroll box parent. OutParent is the parent to check next, null at the top of the hierarchy, where the
+	// result also says whether the hierarchy has been added to a Slate tree. Geometry is from the last
+	// arrange, so a widget scrolled into view is seen one frame late.
+	bool IsShownInParent( const UWidget* Widget, const UWidget*& OutParent )
+	{
+		OutParent = nullptr;
+		const ESlateVisibility Visibility = Widget->GetVisibility();
+		if ( Visibility == ESlateVisibility::Collapsed || Visibility == ESlateVisibility::Hidden )
+		{
+			return false;
+		}
+
+		const UWidget* Parent = Widget->GetParent();
+		if ( Parent == nullptr )
+		{
+			// The root of a user widget's tree carries on with the user widget itself
+			const UWidgetTree* Tree = Cast<UWidgetTree>( Widget->GetOuter() );
+			Parent = Tree ? Cast<UUserWidget>( Tree->GetOuter() ) : nullptr;
+		}
+		if ( Parent == nullptr )
+		{
+			// Not in the viewport or any other Slate tree, so nothing of it is painted
+			const TSharedPtr<SWidget> SlateWidget = Widget->GetCachedWidget();
+			return SlateWidget.IsValid() && SlateWidget->GetParentWidget().IsValid();
+		}
+
+		// Children that were never arranged have no geometry yet and count as shown
+		if ( Parent->IsA<UScrollBox>() && !Widget->GetCachedGeometry().GetLocalSize().IsZero() )
+		{
+			const FSlateRect ChildRect = Widget->GetCachedGeometry().GetRenderBoundingRect();
+			const FSlateRect ViewRect = Parent->GetCachedGeometry().GetRenderBoundingRect();
+			if ( !FSlateRect::DoRectanglesIntersect( ChildRect, ViewRect ) )
+			{
+				return false;
+			}
+		}
+
+		OutParent = Parent;
+		return true;
+	}
+}
+
+FBUITweenManager::FBUITweenManager()
+	: Pool( this )
+{
+	// The default group is always index 0
+	FindOrAddGroup( NAME_None );
+	Reserve();
+	PendingAllocations = FBUITweenAllocationCounters();
+	LastNumHeapBindings = FBUITweenCallback::GetNumHeapBindings();
+	LastNumStorageGrowths = GetNumStorageGrowths();
+
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw( this, &FBUITweenManager::OnPostGarbageCollect );
+}
+
+
+FBUITweenManager::~FBUITweenManager()
+{
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove( PostGarbageCollectHandle );
+}
+
+
+void FBUITweenManager::Reserve()
+{
+	// Everything that grows with the number of live tweens, so steady state never has to
+	const int32 Capacity = GetDefault<UBUITweenSettings>()->InitialTweenCapacity;
+	Pool.Reserve( Capacity );
+	Groups[ 0 ].Prepared.Reserve( Capacity );
+	Groups[ 0 ].Delayed.Reserve( Capacity );
+	Groups[ 0 ].Timings.Reserve( Capacity );
+	Groups[ 0 ].DelayedStarts.Reserve( Capacity );
+	WidgetTweens.Reserve( Capacity );
+	PendingWrites.Reserve( Capacity );
+	DeferredRows.Reserve( Capacity );
+	CompletionQueue.Reserve( Capacity );
+	TimelineCompletions.Reserve( Capacity );
+}
+
+
+void FBUITweenManager::Empty()
+{
+	// Groups keep their time scale and pause state
+	for ( FBUITweenGroup& Group : Groups )
+	{
+		Group.Prepared.Empty();
+		Group.Delayed.Empty();
+		Group.Timings.Empty();
+		Group.DelayedStarts.Empty();
+		FMemory::Memzero( Group.NumPerSet );
+		Group.bHasRemovedRows = false;
+	}
+	for ( TPair< TWeakObjectPtr<UWidget>, FBUITweenWidgetEntry >& Pair : WidgetTweens )
+	{
+		Pair.Value.Base.SyncUMG( Pair.Key.Get() );
+	}
+	WidgetTweens.Empty();
+	Pool.Empty();
+	PendingWrites.Empty();
+	CompletionQueue.Empty();
+	ComputedValues.Empty();
+	GroupValueOffsets.Empty();
+	DeferredRows.Empty();
+	ShownThisUpdate.Empty();
+	ParallelChunks.Empty();
+	Timelines.Empty();
+	TimelineCompletions.Empty();
+	WriteCounters.Reset();
+	PendingAllocations = FBUITweenAllocationCounters();
+	FrameAllocations = FBUITweenAllocationCounters();
+	Reserve();
+}
+
+
+FBUITweenHandle FBUITweenManager::Create( UWidget* pInWidget, float InDuration, float InDelay, bool bIsAdditive, FName InGroup )
+{
+	// By default let's kill any existing tweens
+	if ( !bIsAdditive )
+	{
+		Clear( pInWidget );
+	}
+
+	const int32 GroupIndex = FindOrAddGroup( InGroup );
+	const FBUITweenHandle Handle = Pool.Add( pInWidget, bIsAdditive );
+	Pool.SetTimingGroup( Handle.GetIndex(), GroupIndex );
+	Pool.SetTimingRow( Handle.GetIndex(), Groups[ GroupIndex ].Prepared.Add( Handle.GetIndex(), InDuration, InDelay, NextSequence++ ) );
+	Groups[ GroupIndex ].NumIn( EBUITweenTimingSet::Prepared )++;
+
+	if ( pInWidget )
+	{
+		FBUITweenWidgetEntry& Entry = FindOrAddWidgetEntry( pInWidget );
+		CountGrowth( Entry.Tweens, Entry.Tweens.Num() + 1 );
+		Entry.Tweens.Add( Handle );
+	}
+
+	return Handle;
+}
+
+
+FBUITweenHandle FBUITweenManager::CreateStaggered( TArrayView< UWidget* > Widgets, float InDuration, float InPerItemDelay, float InDelay, bool bIsAdditive, FName InGroup )
+{
+	if ( !bIsAdditive )
+	{
+		for ( UWidget* Widget : Widgets )
+		{
+			Clear( Widget );
+		}
+	}
+
+	// The timing row covers the whole list, each widget's own progress is worked out from it in ApplyStaggered
+	const float TargetDuration = FMath::Max( InDuration, 0.0f );
+	const float TotalDuration = TargetDuration + FMath::Max( Widgets.Num() - 1, 0 ) * FMath::Max( InPerItemDelay, 0.0f );
+
+	const int32 GroupIndex = FindOrAddGroup( InGroup );
+	const FBUITweenHandle Handle = Pool.Add( FBUITweenInstance( Widgets, TargetDuration, InPerItemDelay, bIsAdditive ) );
+	// The instance's list of targets
+	if ( Widgets.Num() > 0 )
+	{
+		PendingAllocations.ContainerGrowths++;
+	}
+	Pool.SetTimingGroup( Handle.GetIndex(), GroupIndex );
+	Pool.SetTimingRow( Handle.GetIndex(), Groups[ GroupIndex ].Prepared.Add( Handle.GetIndex(), TotalDuration, InDelay, NextSequence++ ) );
+	Groups[ GroupIndex ].NumIn( EBUITweenTimingSet::Prepared )++;
+
+	for ( UWidget* Widget : Widgets )
+	{
+		if ( Widget )
+		{
+			FBUITweenWidgetEntry& Entry = FindOrAddWidgetEntry( Widget );
+			CountGrowth( Entry.Tweens, Entry.Tweens.Num() + 1 );
+			Entry.Tweens.Add( Handle );
+		}
+	}
+
+	return Handle;
+}
+
+
+int32 FBUITweenManager::Clear( UWidget* pInWidget )
+{
+	return ClearWidget( pInWidget, 0 );
+}
+
+
+int32 FBUITweenManager::ClearWidget( UWidget* pInWidget, uint32 KeepTimeline )
+{
+	if ( pInWidget == nullptr )
+	{
+		return 0;
+	}
+
+	FBUITweenWidgetEntry* Entry = WidgetTweens.Find( pInWidget );
+	if ( Entry == nullptr )
+	{
+		return 0;
+	}
+
+	int32 NumRemoved = 0;
+	for ( const FBUITweenHandle& Handle : Entry->Tweens )
+	{
+		// Staggered tweens are indexed under every one of their widgets, the entry for this one goes below
+		FBUITweenInstance* Instance = Pool.Get( Handle );
+		if ( Instance )
+		{
+			CommitEmulatedLayout( *Instance );
+		}
+		if ( Instance && Instance->IsStaggered() )
+		{
+			RemoveFromWidgetIndex( *Instance, Handle, pInWidget );
+		}
+		if ( RemoveFromTimings( Handle ) )
+		{
+			NumRemoved++;
+		}
+	}
+	Entry->Tweens.Reset();
+
+	// Stopped tracks don't fire OnComplete, like cancelled tweens
+	for ( int32 i = 0; i < Entry->TimelineTracks.Num(); ++i )
+	{
+		const FBUITweenTimelineTrackRef Ref = Entry->TimelineTracks[ i ];
+		if ( Ref.Timeline == KeepTimeline )
+		{
+			continue;
+		}
+		if ( FBUITweenTimelinePlayback* Timeline = FindTimeline( FBUITweenTimelineHandle( Ref.Timeline, this ) ) )
+		{
+			CommitEmulatedLayout( Timeline->Tracks[ Ref.Track ].Instance );
+			Timeline->ActiveTracks.Remove( Ref.Track );
+			NumRemoved++;
+		}
+		Entry->TimelineTracks.RemoveAtSwap( i--, 1, false );
+	}
+
+	if ( Entry->IsEmpty() )
+	{
+		Entry->Base.SyncUMG( pInWidget );
+		WidgetTweens.Remove( pInWidget );
+	}
+
+	return NumRemoved;
+}
+
+
+void FBUITweenManager::Begin( FBUITweenHandle Handle )
+{
+	FBUITweenInstance* Instance = Pool.Get( Handle );
+	if ( Instance == nullptr )
+	{
+		return;
+	}
+
+	// Delayed tweens wait outside the running stream, so no pass visits them until they are due
+	const EBUITweenTimingSet Set = Pool.GetTimingSet( Handle );
+	if ( Set == EBUITweenTimingSet::Prepared )
+	{
+		MoveTiming( Handle, GetTimings( Handle ).Delay[ Pool.GetTimingRow( Handle ) ] > 0 ? EBUITweenTimingSet::Delayed : EBUITweenTimingSet::Running );
+	}
+
+	const int32 Row = Pool.GetTimingRow( Handle );
+	FBUITweenTimingStream& Timings = GetTimings( Handle );
+	Timings.Flags[ Row ] &= ~EBUITweenTimingFlags::Started;
+
+	// Reduced-rate tweens start at different points of their interval, so ones begun together don't all
+	// land on the same frame
+	const float UpdateInterval = FBUITweenInstance::GetUpdateInterval( Instance->GetUpdateRate() );
+	Timings.UpdateInterval[ Row ] = UpdateInterval;
+	Timings.UpdateCountdown[ Row ] = UpdateInterval * FMath::Frac( ( Timings.Sequence[ Row ] % 1024 ) * 0.618034f );
+	Timings.PendingTime[ Row ] = 0;
+
+	// The easing is only read by the update loop, so resolve it into the hot stream once here
+	// Staggered tweens ease each widget over its own duration rather than the row's
+	const EBUIEasingType EasingType = Instance->GetEasingType();
+	const float Duration = Instance->IsStaggered() ? Instance->GetStaggerTargetDuration() : Timings.Duration[ Row ];
+	Timings.EasingType[ Row ] = EasingType;
+	Timings.EasingFunction[ Row ] = FBUIEasing::Resolve( EasingType );
+	Timings.EasingParam[ Row ] = Instance->GetEasingParam().Get( 0.1f );
+	Timings.EasingPeriod[ Row ] = Duration > 0 ? 1.0f / Duration : 1.0f;
+	if ( Instance->GetEasingParam().IsSet() )
+	{
+		Timings.Flags[ Row ] |= EBUITweenTimingFlags::HasEasingParam;
+	}
+	else
+	{
+		Timings.Flags[ Row ] &= ~EBUITweenTimingFlags::HasEasingParam;
+	}
+	if ( Instance->GetCustomEasing().IsValid() )
+	{
+		Timings.EasingTable[ Row ] = Instance->GetCustomEasing();
+	}
+	else if ( GetDefault<UBUITweenSettings>()->bUseEasingLookupTables )
+	{
+		Timings.EasingTable[ Row ] = FBUIEasingTableCache::GetForTween( EasingType, Duration, Timings.EasingParam[ Row ] );
+	}
+	else
+	{
+		Timings.EasingTable[ Row ].Reset();
+	}
+
+	// Beginning a delayed tween again restarts what is left of its delay. Paused ones are scheduled when
+	// they are unpaused.
+	if ( Pool.GetTimingSet( Handle ) == EBUITweenTimingSet::Delayed )
+	{
+		const bool bWasScheduled = UnscheduleStart( Handle ) >= 0;
+		if ( bWasScheduled || ( Set == EBUITweenTimingSet::Prepared && !EnumHasAnyFlags( Timings.Flags[ Row ], EBUITweenTimingFlags::Paused ) ) )
+		{
+			ScheduleStart( Handle, Timings.Delay[ Row ] );
+		}
+	}
+
+	if ( Instance->IsStaggered() )
+	{
+		Instance->Begin( FWidgetTransform(), 1.0f );
+		for ( FBUITweenTargetState& Target : Instance->GetStaggerTargets() )
+		{
+			if ( UWidget* TargetWidget = Target.Widget.Get() )
+			{
+				FWidgetTransform BaseTransform;
+				float BaseOpacity = 1.0f;
+				const FBUITweenWidgetEntry* Entry = WidgetTweens.Find( TargetWidget );
+				const FBUITweenWidgetBase& Base = Entry ? Entry->Base : FBUITweenWidgetBase();
+				Base.Get( TargetWidget, BaseTransform, BaseOpacity );
+				Instance->BeginTarget( Target, BaseTransform, BaseOpacity );
+			}
+		}
+
+		ApplyStaggered( *Instance, Timings, Row, true );
+		FlushWritesOutsideUpdate();
+		return;
+	}
+
+	// Regular tweens start from the widget's values underneath any additive layers
+	FWidgetTransform BaseTransform;
+	float BaseOpacity = 1.0f;
+	UWidget* Widget = Instance->GetWidget().Get();
+	if ( Widget )
+	{
+		const FBUITweenWidgetEntry* Entry = WidgetTweens.Find( Widget );
+		const FBUITweenWidgetBase& Base = Entry ? Entry->Base : FBUITweenWidgetBase();
+		Base.Get( Widget, BaseTransform, BaseOpacity );
+	}
+
+	Instance->Begin( BaseTransform, BaseOpacity );
+
+	// Apply the starting conditions, even if we delay
+	if ( Widget )
+	{
+		Instance->Apply( 0, false, GetPendingWrites( Widget ), WriteCounters );
+		FlushWritesOutsideUpdate();
+	}
+}
+
+
+bool FBUITweenManager::Cancel( FBUITweenHandle Handle )
+{
+	return Release( Handle );
+}
+
+
+void FBUITweenManager::SetPaused( FBUITweenHandle Handle, bool bInPaused )
+{
+	const int32 Row = Pool.GetTimingRow( Handle );
+	if ( Row == INDEX_NONE )
+	{
+		return;
+	}
+
+	FBUITweenTimingStream& Timings = GetTimings( Handle );
+	const bool bWasPaused = EnumHasAnyFlags( Timings.Flags[ Row ], EBUITweenTimingFlags::Paused );
+	if ( bInPaused )
+	{
+		Timings.Flags[ Row ] |= EBUITweenTimingFlags::Paused;
+	}
+	else
+	{
+		Timings.Flags[ Row ] &= ~EBUITweenTimingFlags::Paused;
+	}
+
+	// A delayed tween's delay stops running while it is paused, the time it has left is kept in its row
+	if ( Pool.GetTimingSet( Handle ) == EBUITweenTimingSet::Delayed && bInPaused != bWasPaused )
+	{
+		if ( bInPaused )
+		{
+			const float Remaining = UnscheduleStart( Handle );
+			if ( Remaining >= 0 )
+			{
+				Timings.Delay[ Row ] = Remaining;
+			}
+		}
+		else
+		{
+			ScheduleStart( Handle, Timings.Delay[ Row ] );
+		}
+	}
+}
+
+
+bool FBUITweenManager::IsPaused( FBUITweenHandle Handle ) const
+{
+	const int32 Row = Pool.GetTimingRow( Handle );
+	return Row != INDEX_NONE && EnumHasAnyFlags( GetTimings( Handle ).Flags[ Row ], EBUITweenTimingFlags::Paused );
+}
+
+
+bool FBUITweenManager::Release( FBUITweenHandle Handle )
+{
+	FBUITweenInstance* Instance = Pool.Get( Handle );
+	if ( Instance == nullptr )
+	{
+		return false;
+	}
+
+	CommitEmulatedLayout( *Instance );
+	RemoveFromWidgetIndex( *Instance, Handle );
+	return RemoveFromTimings( Handle );
+}
+
+
+void FBUITweenManager::CommitEmulatedLayout( FBUITweenInstance& Instance )
+{
+	if ( !Instance.IsEmulatingLayout() )
+	{
+		return;
+	}
+
+	// Finished tweens already committed on their last frame, this only finds tweens cut short
+	bool bHasWrites = false;
+	auto Commit = [ this, &Instance, &bHasWrites ]( FBUITweenTargetState& Target )
+	{
+		UWidget* Widget = Target.Widget.Get();
+		if ( Widget && Target.bHasEmulatedLayout )
+		{
+			Instance.CommitEmulatedLayout( Target, GetPendingWrites( Widget ), WriteCounters );
+			bHasWrites = true;
+		}
+	};
+	if ( Instance.IsStaggered() )
+	{
+		for ( FBUITweenTargetState& Target : Instance.GetStaggerTargets() )
+		{
+			Commit( Target );
+		}
+	}
+	else
+	{
+		Commit( Instance.GetTargetState() );
+	}
+
+	// The widget entries still hold the base the offsets were layered on
+	if ( bHasWrites )
+	{
+		FlushWritesOutsideUpdate();
+	}
+}
+
+
+void FBUITweenManager::RemoveFromWidgetIndex( const FBUITweenInstance& Instance, FBUITweenHandle Handle, const UWidget* pExcept )
+{
+	// Entries for destroyed widgets are pruned right after GC, so a miss here is fine
+	auto RemoveFrom = [ this, Handle, pExcept ]( const TWeakObjectPtr<UWidget>& Widget )
+	{
+		if ( Widget.Get() == pExcept && pExcept != nullptr )
+		{
+			return;
+		}
+		if ( FBUITweenWidgetEntry* Entry = WidgetTweens.Find( Widget ) )
+		{
+			Entry->Tweens.RemoveSingleSwap( Handle, false );
+			if ( Entry->IsEmpty() )
+			{
+				Entry->Base.SyncUMG( Widget.Get() );
+				WidgetTweens.Remove( Widget );
+			}
+		}
+	};
+
+	if ( Instance.IsStaggered() )
+	{
+		for ( const FBUITweenTargetState& Target : Instance.GetStaggerTargets() )
+		{
+			RemoveFrom( Target.Widget );
+		}
+	}
+	else
+	{
+		RemoveFrom( Instance.GetWidget() );
+	}
+}
+
+
+void FBUITweenManager::ComputeParallel( TArrayView< const int32 > NumRows, TArrayView< const float > GroupDeltaTimes )
+{
+	BUITWEEN_SCOPE_CYCLE_COUNTER( STAT_BUITweenCompute );
+
+	// One flat list of fixed-size chunks over every group's rows, so workers share big and small groups evenly
+	const int32 RowsPerChunk = 256;
+	ParallelChunks.Reset();
+	CountGrowth( GroupValueOffsets, NumRows.Num() );
+	GroupValueOffsets.SetNumUninitialized( NumRows.Num(), false );
+	int32 NumValues = 0;
+	for ( int32 GroupIndex = 0; GroupIndex < NumRows.Num(); ++GroupIndex )
+	{
+		GroupValueOffsets[ GroupIndex ] = NumValues;
+		for ( int32 BeginRow = 0; BeginRow < NumRows[ GroupIndex ]; BeginRow += RowsPerChunk )
+		{
+			CountGrowth( ParallelChunks, ParallelChunks.Num() + 1 );
+			ParallelChunks.Add( { GroupIndex, BeginRow, FMath::Min( BeginRow + RowsPerChunk, NumRows[ GroupIndex ] ) } );
+		}
+		NumValues += NumRows[ GroupIndex ];
+	}
+	CountGrowth( ComputedValues, NumValues );
+	ComputedValues.SetNumUninitialized( NumValues, false );
+
+	// Workers only read the pool and each write their own rows of the streams and ComputedValues. No
+	// UObject is touched until the apply pass, back on the game thread.
+	ParallelFor( ParallelChunks.Num(), [ this, GroupDeltaTimes ]( int32 ChunkIndex )
+	{
+		const FBUITweenParallelChunk& Chunk = ParallelChunks[ ChunkIndex ];
+		FBUITweenTimingStream& Timings = Groups[ Chunk.Group ].Timings;
+		Timings.Advance( Chunk.BeginRow, Chunk.EndRow, GroupDeltaTimes[ Chunk.Group ] );
+		Timings.EaseRows( Chunk.BeginRow, Chunk.EndRow );
+
+		FBUITweenValues* Values = &ComputedValues[ GroupValueOffsets[ Chunk.Group ] ];
+		for ( int32 Row = Chunk.BeginRow; Row < Chunk.EndRow; ++Row )
+		{
+			if ( !EnumHasAnyFlags( Timings.Flags[ Row ], EBUITweenTimingFlags::NeedsApply ) )
+			{
+				continue;
+			}
+
+			// Staggered tweens evaluate each of their targets in ApplyStaggered
+			const FBUITweenInstance& Inst = Pool.GetInstanceAt( Timings.SlotIndex[ Row ] );
+			if ( !Inst.IsStaggered() )
+			{
+				Inst.Evaluate( Timings.EasedAlpha[ Row ], Values[ Row ] );
+			}
+		}
+	} );
+}
+
+
+bool FBUITweenManager::IsShown( const UWidget* Widget )
+{
+	// Every widget on the way up is remembered for the rest of the update, so tweens under the same panel
+	// only walk up to it once
+	TArray< const UWidget*, TInlineAllocator<32> > Path;
+	bool bShown = true;
+	for ( const UWidget* Current = Widget; Current != nullptr; )
+	{
+		if ( const bool* Known = ShownThisUpdate.Find( Current ) )
+		{
+			bShown = *Known;
+			break;
+		}
+		Path.Add( Current );
+		const UWidget* Parent = nullptr;
+		if ( !BUITweenCulling::IsShownInParent( Current, Parent ) )
+		{
+			bShown = false;
+			break;
+		}
+		Current = Parent;
+	}
+
+	// Whatever decided it, every widget below on the path is shown exactly when it is
+	const SIZE_T CacheSize = ShownThisUpdate.GetAllocatedSize();
+	for ( const UWidget* Visited : Path )
+	{
+		ShownThisUpdate.Add( Visited, bShown );
+	}
+	if ( ShownThisUpdate.GetAllocatedSize() != CacheSize )
+	{
+		PendingAllocations.ContainerGrowths++;
+	}
+	return bShown;
+}
+
+
+void FBUITweenManager::ApplyRow( int32 GroupIndex, int32 Row, bool bParallel )
+{
+	FBUITweenTimingStream& Timings = Groups[ GroupIndex ].Timings;
+	Timings.Flags[ Row ] &= ~EBUITweenTimingFlags::NeedsApply;
+	Timings.LastApplied[ Row ] = UpdateNumber;
+
+	// A callback earlier in this update may have cancelled us
+	if ( EnumHasAnyFlags( Timings.Flags[ Row ], EBUITweenTimingFlags::Removed ) )
+	{
+		return;
+	}
+
+	FBUITweenInstance& Inst = Pool.GetInstanceAt( Timings.SlotIndex[ Row ] );
+	if ( !Inst.IsStaggered() && !Inst.GetWidget().IsValid() )
+	{
+		Timings.Flags[ Row ] |= EBUITweenTimingFlags::Complete;
+		return;
+	}
+
+	// OnStart may change the tween, so values computed in parallel before it ran are stale
+	bool bJustStarted = false;
+	if ( !EnumHasAnyFlags( Timings.Flags[ Row ], EBUITweenTimingFlags::Started ) )
+	{
+		bJustStarted = true;
+		Timings.Flags[ Row ] |= EBUITweenTimingFlags::Started;
+		BUITweenTrace::OutputTweenStart( Inst.GetWidget().Get(), Timings.Sequence[ Row ], Timings.Duration[ Row ] );
+		{
+			BUITWEEN_SCOPE_CYCLE_COUNTER( STAT_BUITweenCallbacks );
+			Inst.DoStartEvent();
+		}
+		if ( EnumHasAnyFlags( Groups[ GroupIndex ].Timings.Flags[ Row ], EBUITweenTimingFlags::Removed ) )
+		{
+			return;
+		}
+	}
+
+	// Looked up again, the callback above may have added groups or rows
+	FBUITweenTimingStream& CurrentTimings = Groups[ GroupIndex ].Timings;
+	bool bIsFinal = EnumHasAnyFlags( CurrentTimings.Flags[ Row ], EBUITweenTimingFlags::Complete );
+
+	// Culled tweens keep their time but skip the writes, staggered ones per widget in ApplyStaggered
+	EBUITweenCulling Culling = Inst.GetCulling();
+	if ( Culling == EBUITweenCulling::Group )
+	{
+		Culling = Groups[ GroupIndex ].Culling;
+	}
+	bool bSnapped = false;
+	if ( Culling != EBUITweenCulling::None && !bIsFinal && !Inst.IsStaggered() )
+	{
+		if ( !IsShown( Inst.GetWidget().Get() ) )
+		{
+			CurrentTimings.Flags[ Row ] |= EBUITweenTimingFlags::Culled;
+			NumCulled++;
+			return;
+		}
+		if ( Culling == EBUITweenCulling::Complete && EnumHasAnyFlags( CurrentTimings.Flags[ Row ], EBUITweenTimingFlags::Culled ) )
+		{
+			// Shown again, jump to the end and complete in this update. Easings like elastic and back don't
+			// have to end on exactly 1, this lands where a tween that ran to the end would.
+			CurrentTimings.Alpha[ Row ] = CurrentTimings.Duration[ Row ];
+			CurrentTimings.EasedAlpha[ Row ] = CurrentTimings.EaseAt( Row, 1.0f );
+			CurrentTimings.Flags[ Row ] |= EBUITweenTimingFlags::Complete;
+			bIsFinal = true;
+			bSnapped = true;
+		}
+		CurrentTimings.Flags[ Row ] &= ~EBUITweenTimingFlags::Culled;
+	}
+
+	if ( Inst.IsStaggered() )
+	{
+		ApplyStaggered( Inst, CurrentTimings, Row, false, Culling != EBUITweenCulling::None );
+	}
+	else if ( bParallel && !bSnapped && !bJustStarted )
+	{
+		Inst.ApplyValues( ComputedValues[ GroupValueOffsets[ GroupIndex ] + Row ], bIsFinal, GetPendingWrites( Inst.GetWidget().Get() ), WriteCounters );
+	}
+	else
+	{
+		Inst.Apply( CurrentTimings.EasedAlpha[ Row ], bIsFinal, GetPendingWrites( Inst.GetWidget().Get() ), WriteCounters );
+	}
+}
+
+
+void FBUITweenManager::ApplyStaggered( FBUITweenInstance& Instance, const FBUITweenTimingStream& Timings, int32 Row, bool bApplyPending, bool bCull )
+{
+	TArray< FBUITweenTargetState >& Targets = Instance.GetStaggerTargets();
+	const float Time = Timings.Alpha[ Row ];
+	const float Duration = Instance.GetStaggerTargetDuration();
+	const float Interval = Instance.GetStaggerInterval();
+
+	// Neighbouring targets at the same point in their own animation share one easing evaluation, so a
+	// list with no interval eases once however long it is
+	float LastLocalTime = -1.0f;
+	float EasedAlpha = 0;
+	int32 NumFinished = Instance.GetNumStaggerTargetsFinished();
+	for ( int32 Index = NumFinished; Index < Targets.Num(); ++Index )
+	{
+		// Targets start in order, once one hasn't started none of the rest have. Their starting conditions
+		// were applied at Begin, so there is nothing to do for them until they start.
+		const float TargetTime = Time - Index * Interval;
+		if ( TargetTime <= 0 && !bApplyPending && Index > 0 )
+		{
+			break;
+		}
+
+		const float LocalTime = FMath::Clamp( TargetTime, 0.0f, Duration );
+		const bool bIsFinal = !bApplyPending && TargetTime >= Duration;
+		if ( LocalTime != LastLocalTime )
+		{
+			LastLocalTime = LocalTime;
+			EasedAlpha = Timings.EaseAt( Row, Duration > 0 ? LocalTime / Duration : 1.0f );
+		}
+
+		UWidget* Widget = Targets[ Index ].Widget.Get();
+		if ( Widget && bCull && !bIsFinal && !IsShown( Widget ) )
+		{
+			NumCulled++;
+		}
+		else if ( Widget )
+		{
+			Instance.ApplyTarget( Targets[ Index ], EasedAlpha, bIsFinal, GetPendingWrites( Widget ), WriteCounters );
+		}
+
+		// Targets finish in order too, so finished ones are always a prefix of the list
+		if ( bIsFinal && Index == NumFinished )
+		{
+			NumFinished++;
+		}
+	}
+	Instance.SetNumStaggerTargetsFinished( NumFinished );
+}
+
+
+bool FBUITweenManager::RemoveFromTimings( FBUITweenHandle Handle )
+{
+	const int32 Row = Pool.GetTimingRow( Handle );
+	if ( Row == INDEX_NONE )
+	{
+		return false;
+	}
+
+	// Only flag the row, it is compacted away at the end of the next update. This keeps rows stable while
+	// Update walks them, so tween callbacks can safely cancel or clear tweens.
+	// A delayed tween's heap entry is left in, it is skipped once it comes up.
+	FBUITweenGroup& Group = Groups[ Pool.GetTimingGroup( Handle ) ];
+	const EBUITweenTimingSet Set = Pool.GetTimingSet( Handle );
+	Group.GetStream( Set ).Flags[ Row ] |= EBUITweenTimingFlags::Removed;
+	Group.NumIn( Set )--;
+	Group.bHasRemovedRows = true;
+	return Pool.Remove( Handle );
+}
+
+
+FBUITweenTimingStream& FBUITweenManager::GetTimings( FBUITweenHandle Handle )
+{
+	return Groups[ Pool.GetTimingGroup( Handle ) ].GetStream( Pool.GetTimingSet( Handle ) );
+}
+
+
+const FBUITweenTimingStream& FBUITweenManager::GetTimings( FBUITweenHandle Handle ) const
+{
+	return Groups[ Pool.GetTimingGroup( Handle ) ].GetStream( Pool.GetTimingSet( Handle ) );
+}
+
+
+int32 FBUITweenManager::MoveTiming( FBUITweenHandle Handle, EBUITweenTimingSet To )
+{
+	FBUITweenGroup& Group = Groups[ Pool.GetTimingGroup( Handle ) ];
+	const EBUITweenTimingSet From = Pool.GetTimingSet( Handle );
+	const int32 Row = Pool.GetTimingRow( Handle );
+	FBUITweenTimingStream& FromStream = Group.GetStream( From );
+	const int32 NewRow = Group.GetStream( To ).AddFrom( FromStream, Row );
+
+	// The old row goes the way of a cancelled one, so rows an update is walking don't move
+	FromStream.Flags[ Row ] |= EBUITweenTimingFlags::Removed;
+	Group.bHasRemovedRows = true;
+	Group.NumIn( From )--;
+	Group.NumIn( To )++;
+	Pool.SetTimingRow( Handle.GetIndex(), NewRow );
+	Pool.SetTimingSet( Handle.GetIndex(), To );
+	return NewRow;
+}
+
+
+void FBUITweenManager::ScheduleStart( FBUITweenHandle Handle, float InDelay )
+{
+	FBUITweenGroup& Group = Groups[ Pool.GetTimingGroup( Handle ) ];
+	const uint32 Sequence = Group.Delayed.Sequence[ Pool.GetTimingRow( Handle ) ];
+	CountGrowth( Group.DelayedStarts, Group.DelayedStarts.Num() + 1 );
+	Group.DelayedStarts.HeapPush( { Group.Clock + FMath::Max( InDelay, 0.0f ), Sequence, Handle } );
+}
+
+
+float FBUITweenManager::UnscheduleStart( FBUITweenHandle Handle )
+{
+	// Only pausing and beginning again get here, so a linear search is fine
+	FBUITweenGroup& Group = Groups[ Pool.GetTimingGroup( Handle ) ];
+	const int32 Index = Group.DelayedStarts.IndexOfByPredicate( [ Handle ]( const FBUITweenDelayedStart& Start ) { return Start.Handle == Handle; } );
+	if ( Index == INDEX_NONE )
+	{
+		return -1.0f;
+	}
+
+	const float Remaining = (float)FMath::Max( Group.DelayedStarts[ Index ].StartTime - Group.Clock, 0.0 );
+	Group.DelayedStarts.HeapRemoveAt( Index, false );
+	return Remaining;
+}
+
+
+void FBUITweenManager::StartDueTweens( int32 GroupIndex, float GroupDeltaTime )
+{
+	FBUITweenGroup& Group = Groups[ GroupIndex ];
+	while ( Group.DelayedStarts.Num() > 0 && Group.DelayedStarts.HeapTop().StartTime <= Group.Clock )
+	{
+		const FBUITweenDelayedStart Start = Group.DelayedStarts.HeapTop();
+		Group.DelayedStarts.HeapPopDiscard( false );
+
+		// Cancelled while delayed, the handle is stale
+		if ( Pool.Get( Start.Handle ) == nullptr )
+		{
+			continue;
+		}
+
+		const int32 Row = MoveTiming( Start.Handle, EBUITweenTimingSet::Running );
+
+		// Negative by the part of this update that passed before the delay ran out, so once the advance pass
+		// adds the whole update the tween is exactly as far along as the time since its start
+		Group.Timings.Alpha[ Row ] = (float)( Group.Clock - Start.StartTime ) - GroupDeltaTime;
+		Group.Timings.Delay[ Row ] = 0;
+	}
+}
+
+
+void FBUITweenManager::OnPostGarbageCollect()
+{
+	// The tweens themselves notice their widget is gone on their next update, we only prune the index
+	for ( auto It = WidgetTweens.CreateIterator(); It; ++It )
+	{
+		if ( !It.Key().IsValid() )
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+
+FBUITweenWidgetWrites& FBUITweenManager::GetPendingWrites( UWidget* pInWidget )
+{
+	FBUITweenWidgetEntry* Entry = WidgetTweens.Find( pInWidget );
+	if ( Entry && Entry->PendingWriteFrame == WriteFrame )
+	{
+		return PendingWrites[ Entry->PendingWrite ];
+	}
+
+	CountGrowth( PendingWrites, PendingWrites.Num() + 1 );
+	const int32 Index = PendingWrites.AddDefaulted();
+	PendingWrites[ Index ].Widget = pInWidget;
+	if ( Entry )
+	{
+		Entry->PendingWrite = Index;
+		Entry->PendingWriteFrame = WriteFrame;
+	}
+	return PendingWrites[ Index ];
+}
+
+
+void FBUITweenManager::FlushWrites()
+{
+	BUITWEEN_SCOPE_CYCLE_COUNTER( STAT_BUITweenApplyRender );
+
+	// A widget without an entry has no base to remember the unsynced values in, so it goes through UMG
+	const bool bWriteSlate = GetDefault<UBUITweenSettings>()->bWriteSlateDirectly;
+	for ( FBUITweenWidgetWrites& Writes : PendingWrites )
+	{
+		// The entry may have been cleared by a callback since the writes were gathered
+		FBUITweenWidgetEntry* Entry = WidgetTweens.Find( Writes.Widget );
+		FBUITweenWidgetBase DetachedBase;
+		Writes.Flush( Entry ? Entry->Base : DetachedBase, WriteCounters, bWriteSlate && Entry != nullptr );
+	}
+	PendingWrites.Reset();
+	WriteFrame++;
+}
+
+
+void FBUITweenManager::FlushWritesOutsideUpdate()
+{
+	// Flushing in the middle of an update would give a widget a second write this frame, and the tweens
+	// applied after it would start a new accumulator without the earlier additive layers
+	if ( UpdateDepth == 0 )
+	{
+		FlushWrites();
+	}
+}
+
+
+FBUITweenInstance* FBUITweenManager::GetInstance( FBUITweenHandle Handle ) const
+{
+	return Pool.Get( Handle );
+}
+
+
+void FBUITweenManager::Update( float DeltaTime )
+{
+	Time += DeltaTime;
+	Tick( DeltaTime );
+}
+
+
+void FBUITweenManager::Tick( float DeltaTime, bool bComplete, int32 OnlyGroup )
+{
+	BUITWEEN_SCOPE_CYCLE_COUNTER( STAT_BUITweenUpdate );
+
+	WriteCounters.Reset();
+	NumCulled = 0;
+	ShownThisUpdate.Reset();
+	UpdateDepth++;
+	UpdateNumber++;
+
+	// Rows and groups added by callbacks during this update are left alone until the next one. Paused groups
+	// get no rows at all, so none of their tweens are visited.
+	// Delayed tweens that come due join their group's running stream first, so they advance in this update.
+	// Completing takes every delayed tween, due or not.
+	TArray< int32, TInlineAllocator<16> > NumRows;
+	TArray< float, TInlineAllocator<16> > GroupDeltaTimes;
+	NumRows.SetNumUninitialized( Groups.Num() );
+	GroupDeltaTimes.SetNumUninitialized( Groups.Num() );
+	int32 NumRunningRows = 0;
+	for ( int32 GroupIndex = 0; GroupIndex < NumRows.Num(); ++GroupIndex )
+	{
+		FBUITweenGroup& Group = Groups[ GroupIndex ];
+		const bool bRun = bComplete ? OnlyGroup == INDEX_NONE || GroupIndex == OnlyGroup : !Group.bIsPaused;
+		GroupDeltaTimes[ GroupIndex ] = DeltaTime * Group.TimeScale;
+		if ( bRun && bComplete )
+		{
+			StartAllDelayed( GroupIndex );
+		}
+		else if ( bRun )
+		{
+			Group.Clock += GroupDeltaTimes[ GroupIndex ];
+			StartDueTweens( GroupIndex, GroupDeltaTimes[ GroupIndex ] );
+		}
+		NumRows[ GroupIndex ] = bRun ? Group.Timings.Num() : 0;
+		NumRunningRows += NumRows[ GroupIndex ];
+	}
+	const int32 NumTimelines = Timelines.Num();
+
+	// Enough running tweens and the math is spread over worker threads, see ComputeParallel. Only the
+	// outermost update does this, a nested one would overwrite ComputedValues under the outer apply pass.
+	const int32 ParallelThreshold = GetDefault<UBUITweenSettings>()->ParallelUpdateThreshold;
+	const bool bParallel = ParallelThreshold > 0 && NumRunningRows >= ParallelThreshold && UpdateDepth == 1 && !bComplete;
+	if ( bParallel )
+	{
+		ComputeParallel( NumRows, GroupDeltaTimes );
+	}
+	else
+	{
+		// Advance time, this only touches the timing streams
+		{
+			BUITWEEN_SCOPE_CYCLE_COUNTER( STAT_BUITweenAdvance );
+			for ( int32 GroupIndex = 0; GroupIndex < NumRows.Num(); ++GroupIndex )
+			{
+				if ( bComplete )
+				{
+					Groups[ GroupIndex ].Timings.Finish( 0, NumRows[ GroupIndex ] );
+				}
+				else
+				{
+					Groups[ GroupIndex ].Timings.Advance( 0, NumRows[ GroupIndex ], GroupDeltaTimes[ GroupIndex ] );
+				}
+			}
+		}
+
+		// Ease, batched by easing type
+		{
+			BUITWEEN_SCOPE_CYCLE_COUNTER( STAT_BUITweenEase );
+			for ( int32 GroupIndex = 0; GroupIndex < NumRows.Num(); ++GroupIndex )
+			{
+				Groups[ GroupIndex ].Timings.Ease( NumRows[ GroupIndex ] );
+			}
+		}
+	}
+
+	// With a budget, reduced-rate tweens are applied after everything else and only for as long as the
+	// budget allows. Only the outermost update does this, DeferredRows is shared.
+	const float UpdateBudgetMs = GetDefault<UBUITweenSettings>()->UpdateBudgetMs;
+	const bool bBudgeted = UpdateBudgetMs > 0 && UpdateDepth == 1;
+
+	// Apply the property tracks, this is the only pass that touches the instances. Transform and opacity are
+	// gathered per widget and written once in FlushWrites below.
+	{
+		BUITWEEN_SCOPE_CYCLE_COUNTER( STAT_BUITweenApply );
+		for ( int32 GroupIndex = 0; GroupIndex < NumRows.Num(); ++GroupIndex )
+		{
+			for ( int32 Row = 0; Row < NumRows[ GroupIndex ]; ++Row )
+			{
+				// Looked up per row, callbacks below may add groups and move the array
+				const FBUITweenTimingStream& Timings = Groups[ GroupIndex ].Timings;
+				if ( !EnumHasAnyFlags( Timings.Flags[ Row ], EBUITweenTimingFlags::NeedsApply ) )
+				{
+					continue;
+				}
+
+				// Reduced-rate tweens wait for whatever budget is left below, unless they are finishing
+				if ( bBudgeted && Timings.UpdateInterval[ Row ] > 0 && !EnumHasAnyFlags( Timings.Flags[ Row ], EBUITweenTimingFlags::Complete ) )
+				{
+					CountGrowth( DeferredRows, DeferredRows.Num() + 1 );
+					DeferredRows.Add( { Timings.LastApplied[ Row ], GroupIndex, Row } );
+					continue;
+				}
+				ApplyRow( GroupIndex, Row, bParallel );
+			}
+		}
+
+		// Deferred tweens go longest waiting first. Ones that don't fit keep NeedsApply and their time, and
+		// are applied in a later update with everything up to then, ahead of the ones applied this time. At
+		// least one is applied per update, so even a budget too small for any of them gets through the list.
+		NumOverBudget = 0;
+		if ( DeferredRows.Num() > 0 )
+		{
+			DeferredRows.Sort();
+
+			// The budget is theirs alone, advancing and applying everything else doesn't count against it
+			const uint64 BudgetEndCycles = FPlatformTime::Cycles64() + (uint64)( UpdateBudgetMs / ( 1000.0 * FPlatformTime::GetSecondsPerCycle64() ) );
+			const int32 NumDeferred = DeferredRows.Num();
+			int32 NumApplied = 0;
+			while ( NumApplied < NumDeferred && ( NumApplied == 0 || FPlatformTime::Cycles64() < BudgetEndCycles ) )
+			{
+				const FBUITweenDeferredRow& Deferred = DeferredRows[ NumApplied++ ];
+				ApplyRow( Deferred.Group, Deferred.Row, bParallel );
+			}
+			NumOverBudget = NumDeferred - NumApplied;
+			DeferredRows.Reset();
+		}
+
+		// Timelines don't belong to a group, so completing one group leaves them be. Completing everything
+		// runs them far enough to finish every track.
+		if ( OnlyGroup == INDEX_NONE )
+		{
+			AdvanceTimelines( bComplete ? TNumericLimits< float >::Max() : DeltaTime, NumTimelines );
+		}
+
+		// Before the completion pass, so OnComplete sees the final values on the widget
+		FlushWrites();
+	}
+
+	// Queue everything that finished and release it up front, so callbacks see a consistent state
+	for ( int32 GroupIndex = 0; GroupIndex < NumRows.Num(); ++GroupIndex )
+	{
+		const FBUITweenTimingStream& Timings = Groups[ GroupIndex ].Timings;
+		for ( int32 Row = 0; Row < NumRows[ GroupIndex ]; ++Row )
+		{
+			if ( EnumHasAnyFlags( Timings.Flags[ Row ], EBUITweenTimingFlags::Complete )
+				&& !EnumHasAnyFlags( Timings.Flags[ Row ], EBUITweenTimingFlags::Removed ) )
+			{
+				const int32 SlotIndex = Timings.SlotIndex[ Row ];
+				CountGrowth( CompletionQueue, CompletionQueue.Num() + 1 );
+				CompletionQueue.Add( { Timings.Sequence[ Row ], SlotIndex } );
+				Release( Pool.GetHandleAt( SlotIndex ) );
+			}
+		}
+	}
+
+	const int32 NumCompleted = CompletionQueue.Num() + TimelineCompletions.Num();
+	if ( CompletionQueue.Num() > 0 )
+	{
+		BUITWEEN_SCOPE_CYCLE_COUNTER( STAT_BUITweenCallbacks );
+
+		// Sorted across groups, so callbacks keep creation order whichever groups the tweens are in
+		CompletionQueue.Sort();
+
+		// Swapped out in case a callback calls Update again
+		TArray< FBUITweenCompletion > Queue = MoveTemp( CompletionQueue );
+		for ( const FBUITweenCompletion& Completion : Queue )
+		{
+			// Pool slots are only recycled at the end of the update, so the instance stays put while its
+			// callback runs even if the callback creates or clears tweens
+			FBUITweenInstance& Inst = Pool.GetInstanceAt( Completion.SlotIndex );
+			BUITweenTrace::OutputTweenComplete( Inst.GetWidget().Get(), Completion.Sequence );
+			Inst.DoCompleteCleanup();
+		}
+		Queue.Reset();
+		CompletionQueue = MoveTemp( Queue );
+	}
+
+	if ( TimelineCompletions.Num() > 0 )
+	{
+		BUITWEEN_SCOPE_CYCLE_COUNTER( STAT_BUITweenCallbacks );
+
+		// Already in the order the tracks finished
+		TArray< FBUITweenTimelineCompletion > Queue = MoveTemp( TimelineCompletions );
+		for ( const FBUITweenTimelineCompletion& Completion : Queue )
+		{
+			Timelines[ Completion.Timeline ]->Tracks[ Completion.Track ].Instance.DoCompleteCleanup();
+		}
+		Queue.Reset();
+		TimelineCompletions = MoveTemp( Queue );
+	}
+
+	// Starting conditions of tweens begun by the callbacks above, and layouts committed by ones they cancelled
+	if ( PendingWrites.Num() > 0 )
+	{
+		FlushWrites();
+	}
+
+#if STATS
+	int32 NumPerSet[ (int32)EBUITweenTimingSet::Num ] = {};
+	for ( const FBUITweenGroup& Group : Groups )
+	{
+		for ( int32 Set = 0; Set < (int32)EBUITweenTimingSet::Num; ++Set )
+		{
+			NumPerSet[ Set ] += Group.NumPerSet[ Set ];
+		}
+	}
+	SET_DWORD_STAT( STAT_BUITweenPrepared, NumPerSet[ (int32)EBUITweenTimingSet::Prepared ] );
+	SET_DWORD_STAT( STAT_BUITweenDelayed, NumPerSet[ (int32)EBUITweenTimingSet::Delayed ] );
+	SET_DWORD_STAT( STAT_BUITweenRunning, NumPerSet[ (int32)EBUITweenTimingSet::Running ] );
+#endif
+	SET_DWORD_STAT( STAT_BUITweenCompleted, NumCompleted );
+	SET_DWORD_STAT( STAT_BUITweenCulled, NumCulled );
+	SET_DWORD_STAT( STAT_BUITweenOverBudget, NumOverBudget );
+	SET_DWORD_STAT( STAT_BUITweenSetterCalls, WriteCounters.Issued );
+	SET_DWORD_STAT( STAT_BUITweenSetterCallsSkipped, WriteCounters.Skipped );
+
+	// A callback calling Update (CompleteAll, say) must not move rows or recycle slots the outer update still
+	// has to walk
+	UpdateDepth--;
+	if ( UpdateDepth == 0 )
+	{
+		// Compact away completed and cancelled rows. No callbacks run from here on, so rows can move freely.
+		// Only groups that lost a row are walked, paused ones included so cancelling them still frees rows.
+		{
+			BUITWEEN_SCOPE_CYCLE_COUNTER( STAT_BUITweenCompact );
+			for ( FBUITweenGroup& Group : Groups )
+			{
+				if ( !Group.bHasRemovedRows )
+				{
+					continue;
+				}
+				Group.bHasRemovedRows = false;
+
+				// A tween only has a live row in one of the three, so the slot always follows the row that moved
+				for ( FBUITweenTimingStream* Timings : { &Group.Prepared, &Group.Delayed, &Group.Timings } )
+				{
+					for ( int32 Row = Timings->Num() - 1; Row >= 0; --Row )
+					{
+						if ( EnumHasAnyFlags( Timings->Flags[ Row ], EBUITweenTimingFlags::Removed ) )
+						{
+							const int32 MovedSlotIndex = Timings->RemoveAtSwap( Row );
+							if ( MovedSlotIndex != INDEX_NONE )
+							{
+								Pool.SetTimingRow( MovedSlotIndex, Row );
+							}
+						}
+					}
+				}
+			}
+		}
+
+		Pool.ReleasePendingSlots();
+
+		Timelines.RemoveAll( []( const TUniquePtr< FBUITweenTimelinePlayback >& Timeline ) { return Timeline->bIsFinished; } );
+	}
+
+	if ( UpdateDepth == 0 )
+	{
+		const int32 NumHeapBindings = FBUITweenCallback::GetNumHeapBindings();
+		PendingAllocations.HeapCallbacks = NumHeapBindings - LastNumHeapBindings;
+		LastNumHeapBindings = NumHeapBindings;
+		const int32 NumStorageGrowths = GetNumStorageGrowths();
+		PendingAllocations.ContainerGrowths += NumStorageGrowths - LastNumStorageGrowths;
+		LastNumStorageGrowths = NumStorageGrowths;
+
+		FrameAllocations = PendingAllocations;
+		PendingAllocations = FBUITweenAllocationCounters();
+		SET_DWORD_STAT( STAT_BUITweenAllocations, FrameAllocations.Num() );
+	}
+}
+
+
+int32 FBUITweenManager::GetNumStorageGrowths() const
+{
+	int32 NumGrowths = Pool.GetNumGrowths();
+	for ( const FBUITweenGroup& Group : Groups )
+	{
+		NumGrowths += Group.Prepared.GetNumGrowths() + Group.Delayed.GetNumGrowths() + Group.Timings.GetNumGrowths();
+	}
+	return NumGrowths;
+}
+
+
+FBUITweenWidgetEntry& FBUITweenManager::FindOrAddWidgetEntry( UWidget* pInWidget )
+{
+	if ( FBUITweenWidgetEntry* Entry = WidgetTweens.Find( pInWidget ) )
+	{
+		return *Entry;
+	}
+
+	// Only a new entry can grow the map
+	const SIZE_T MapSize = WidgetTweens.GetAllocatedSize();
+	FBUITweenWidgetEntry& Entry = WidgetTweens.Add( pInWidget );
+	if ( WidgetTweens.GetAllocatedSize() != MapSize )
+	{
+		PendingAllocations.ContainerGrowths++;
+	}
+	return Entry;
+}
+
+
+SIZE_T FBUITweenManager::GetAllocatedSize() const
+{
+	SIZE_T Size = Pool.GetAllocatedSize() + Groups.GetAllocatedSize() + GroupIndices.GetAllocatedSize()
+		+ WidgetTweens.GetAllocatedSize() + PendingWrites.GetAllocatedSize() + CompletionQueue.GetAllocatedSize()
+		+ DeferredRows.GetAllocatedSize() + ShownThisUpdate.GetAllocatedSize();
+	for ( const FBUITweenGroup& Group : Groups )
+	{
+		Size += Group.Prepared.GetAllocatedSize() + Group.Delayed.GetAllocatedSize() + Group.Timings.GetAllocatedSize()
+			+ Group.DelayedStarts.GetAllocatedSize();
+	}
+	Size += ComputedValues.GetAllocatedSize() + GroupValueOffsets.GetAllocatedSize() + ParallelChunks.GetAllocatedSize();
+	Size += Timelines.GetAllocatedSize() + TimelineCompletions.GetAllocatedSize();
+	for ( const TUniquePtr< FBUITweenTimelinePlayback >& Timeline : Timelines )
+	{
+		Size += sizeof( FBUITweenTimelinePlayback ) + Timeline->Tracks.GetAllocatedSize() + Timeline->ActiveTracks.GetAllocatedSize();
+	}
+	return Size;
+}
+
+
+void FBUITweenManager::SetFixedStep( float InFixedStep, int32 InMaxSubsteps )
+{
+	FixedStep = FMath::Max( InFixedStep, 0.0f );
+	MaxSubsteps = FMath::Max( InMaxSubsteps, 1 );
+	StepAccumulator = 0;
+}
+
+
+int32 FBUITweenManager::Step( float DeltaTime )
+{
+	if ( FixedStep <= 0 )
+	{
+		Update( DeltaTime );
+		return 1;
+	}
+
+	StepAccumulator += DeltaTime;
+	int32 NumSteps = 0;
+	while ( StepAccumulator >= FixedStep && NumSteps < MaxSubsteps )
+	{
+		Update( FixedStep );
+		StepAccumulator -= FixedStep;
+		NumSteps++;
+	}
+
+	// Out of substeps, drop the backlog rather than carrying it into the next call
+	if ( StepAccumulator >= FixedStep )
+	{
+		StepAccumulator = 0;
+	}
+	return NumSteps;
+}
+
+
+int32 FBUITweenManager::SeekTo( double InTime )
+{
+	if ( !ensureMsgf( InTime >= Time, TEXT( "SeekTo only seeks forwards, %f is before the current time %f" ), InTime, Time ) )
+	{
+		return 0;
+	}
+
+	if ( FixedStep <= 0 )
+	{
+		if ( InTime == Time )
+		{
+			return 0;
+		}
+		Update( (float)( InTime - Time ) );
+		return 1;
+	}
+
+	// The tolerance keeps a target that is a whole number of steps away from being missed to rounding
+	const double Tolerance = FixedStep * 1.e-3;
+	int32 NumSteps = 0;
+	while ( Time + FixedStep <= InTime + Tolerance )
+	{
+		Update( FixedStep );
+		NumSteps++;
+	}
+	StepAccumulator = 0;
+	return NumSteps;
+}
+
+
+FBUITweenTimelineHandle FBUITweenManager::Play( FBUITweenTimeline&& Timeline )
+{
+	// The playback object and its list of active tracks always allocate
+	TUniquePtr< FBUITweenTimelinePlayback > Playback = MakeUnique< FBUITweenTimelinePlayback >();
+	PendingAllocations.ContainerGrowths++;
+	Playback->Id = NextTimelineId++;
+	Playback->Tracks = MoveTemp( Timeline.Tracks );
+	Timeline.Tracks.Reset();
+	Timeline.StepStart = 0;
+	Timeline.End = 0;
+
+	// Compile: sort by start so the cursor only ever moves forwards, With tracks keep the order they were added
+	Playback->Tracks.StableSort( []( const FBUITweenTimelineTrack& A, const FBUITweenTimelineTrack& B ) { return A.Start < B.Start; } );
+	const bool bUseEasingLookupTables = GetDefault<UBUITweenSettings>()->bUseEasingLookupTables;
+	for ( FBUITweenTimelineTrack& Track : Playback->Tracks )
+	{
+		const EBUIEasingType EasingType = Track.Instance.GetEasingType();
+		Track.EasingFunction = FBUIEasing::Resolve( EasingType );
+		Track.EasingParam = Track.Instance.GetEasingParam().Get( 0.1f );
+		Track.EasingTable = Track.Instance.GetCustomEasing();
+		if ( !Track.EasingTable.IsValid() && bUseEasingLookupTables )
+		{
+			Track.EasingTable = FBUIEasingTableCache::GetForTween( EasingType, Track.Duration, Track.EasingParam );
+		}
+	}
+	if ( Playback->Tracks.Num() > 0 )
+	{
+		Playback->ActiveTracks.Reserve( Playback->Tracks.Num() );
+		PendingAllocations.ContainerGrowths++;
+	}
+
+	const FBUITweenTimelineHandle Handle( Playback->Id, this );
+	CountGrowth( Timelines, Timelines.Num() + 1 );
+	Timelines.Add( MoveTemp( Playback ) );
+	return Handle;
+}
+
+
+bool FBUITweenManager::StopTimeline( FBUITweenTimelineHandle Handle )
+{
+	FBUITweenTimelinePlayback* Timeline = FindTimeline( Handle );
+	if ( Timeline == nullptr )
+	{
+		return false;
+	}
+
+	// Tracks that already finished this update still get their OnComplete
+	Timeline->bIsFinished = true;
+	for ( int32 TrackIndex : Timeline->ActiveTracks )
+	{
+		RemoveTrackFromWidgetIndex( *Timeline, TrackIndex );
+	}
+	Timeline->ActiveTracks.Reset();
+	return true;
+}
+
+
+bool FBUITweenManager::IsTimelinePlaying( FBUITweenTimelineHandle Handle ) const
+{
+	return FindTimeline( Handle ) != nullptr;
+}
+
+
+FBUITweenTimelinePlayback* FBUITweenManager::FindTimeline( FBUITweenTimelineHandle Handle ) const
+{
+	if ( Handle.GetManager() != this )
+	{
+		return nullptr;
+	}
+
+	// Only a handful of timelines play at once, a linear search is fine
+	for ( const TUniquePtr< FBUITweenTimelinePlayback >& Timeline : Timelines )
+	{
+		if ( Timeline->Id == Handle.GetId() )
+		{
+			return Timeline->bIsFinished ? nullptr : Timeline.Get();
+		}
+	}
+	return nullptr;
+}
+
+
+void FBUITweenManager::AddTrackToWidgetIndex( const FBUITweenTimelinePlayback& Timeline, int32 TrackIndex )
+{
+	if ( UWidget* Widget = Timeline.Tracks[ TrackIndex ].Instance.GetWidget().Get() )
+	{
+		FBUITweenWidgetEntry& Entry = FindOrAddWidgetEntry( Widget );
+		CountGrowth( Entry.TimelineTracks, Entry.TimelineTracks.Num() + 1 );
+		Entry.TimelineTracks.Add( { Timeline.Id, TrackIndex } );
+	}
+}
+
+
+void FBUITweenManager::RemoveTrackFromWidgetIndex( const FBUITweenTimelinePlayback& Timeline, int32 TrackIndex )
+{
+	const TWeakObjectPtr<UWidget> Widget = Timeline.Tracks[ TrackIndex ].Instance.GetWidget();
+	if ( FBUITweenWidgetEntry* Entry = WidgetTweens.Find( Widget ) )
+	{
+		Entry->TimelineTracks.RemoveSingleSwap( { Timeline.Id, TrackIndex }, false );
+		if ( Entry->IsEmpty() )
+		{
+			Entry->Base.SyncUMG( Widget.Get() );
+			WidgetTweens.Remove( Widget );
+		}
+	}
+}
+
+
+void FBUITweenManager::AdvanceTimelines( float DeltaTime, int32 NumTimelines )
+{
+	for ( int32 TimelineIndex = 0; TimelineIndex < NumTimelines; ++TimelineIndex )
+	{
+		FBUITweenTimelinePlayback& Timeline = *Timelines[ TimelineIndex ];
+		if ( Timeline.bIsFinished )
+		{
+			continue;
+		}
+		Timeline.Time += DeltaTime;
+
+		// Start every track that is due, in order. Anything ending before a track starts is finished and
+		// flushed first, so a Then on the same widget starts from its final values even within one update.
+		while ( !Timeline.bIsFinished && Timeline.NextTrack < Timeline.Tracks.Num()
+			&& Timeline.Tracks[ Timeline.NextTrack ].Start <= Timeline.Time )
+		{
+			FBUITweenTimelineTrack& Track = Timeline.Tracks[ Timeline.NextTrack ];
+			if ( ApplyTimelineTracks( TimelineIndex, Track.Start, true ) > 0 )
+			{
+				FlushWrites();
+			}
+
+			// Like Create, a non-additive track takes the widget over from other tweens and timelines
+			FWidgetTransform BaseTransform;
+			float BaseOpacity = 1.0f;
+			UWidget* Widget = Track.Instance.GetWidget().Get();
+			if ( Widget )
+			{
+				if ( !Track.Instance.IsAdditive() )
+				{
+					ClearWidget( Widget, Timeline.Id );
+				}
+				const FBUITweenWidgetEntry* Entry = WidgetTweens.Find( Widget );
+				const FBUITweenWidgetBase& Base = Entry ? Entry->Base : FBUITweenWidgetBase();
+				Base.Get( Widget, BaseTransform, BaseOpacity );
+			}
+			Track.Instance.Begin( BaseTransform, BaseOpacity );
+			AddTrackToWidgetIndex( Timeline, Timeline.NextTrack );
+			Timeline.ActiveTracks.Add( Timeline.NextTrack++ );
+
+			// Starting conditions, as Begin applies them for a tween
+			if ( Widget )
+			{
+				Track.Instance.Apply( 0, false, GetPendingWrites( Widget ), WriteCounters );
+			}
+
+			BUITWEEN_SCOPE_CYCLE_COUNTER( STAT_BUITweenCallbacks );
+			Track.Instance.DoStartEvent();
+		}
+
+		if ( !Timeline.bIsFinished )
+		{
+			ApplyTimelineTracks( TimelineIndex, Timeline.Time, false );
+			Timeline.bIsFinished = Timeline.NextTrack == Timeline.Tracks.Num() && Timeline.ActiveTracks.Num() == 0;
+		}
+	}
+}
+
+
+int32 FBUITweenManager::ApplyTimelineTracks( int32 TimelineIndex, float At, bool bOnlyFinishing )
+{
+	FBUITweenTimelinePlayback& Timeline = *Timelines[ TimelineIndex ];
+
+	int32 NumFinished = 0;
+	for ( int32 i = 0; i < Timeline.ActiveTracks.Num(); ++i )
+	{
+		const int32 TrackIndex = Timeline.ActiveTracks[ i ];
+		FBUITweenTimelineTrack& Track = Timeline.Tracks[ TrackIndex ];
+		const float LocalTime = At - Track.Start;
+		const bool bIsFinal = LocalTime >= Track.Duration;
+		if ( bOnlyFinishing && !bIsFinal )
+		{
+			continue;
+		}
+
+		UWidget* Widget = Track.Instance.GetWidget().Get();
+		if ( Widget )
+		{
+			// The last frame eases exactly 1 in, like a tween's, rather than wherever LocalTime overshot to
+			const float T = bIsFinal ? 1.0f : LocalTime / Track.Duration;
+			const float EasedAlpha = Track.EasingTable
+				? Track.EasingTable->Sample( T )
+				: Track.EasingFunction( T, Track.EasingParam, Track.Duration > 0 ? 1.0f / Track.Duration : 1.0f );
+			Track.Instance.Apply( EasedAlpha, bIsFinal, GetPendingWrites( Widget ), WriteCounters );
+		}
+
+		// Like regular tweens, a track whose widget is gone counts as finished
+		if ( bIsFinal || Widget == nullptr )
+		{
+			// Keeps the rest in start order, the list is short and this only happens once per track
+			Timeline.ActiveTracks.RemoveAt( i--, 1, false );
+			RemoveTrackFromWidgetIndex( Timeline, TrackIndex );
+			CountGrowth( TimelineCompletions, TimelineCompletions.Num() + 1 );
+			TimelineCompletions.Add( { TimelineIndex, TrackIndex } );
+			NumFinished++;
+		}
+	}
+	return NumFinished;
+}
+
+
+int32 FBUITweenManager::FindOrAddGroup( FName InGroup )
+{
+	if ( const int32* Index = GroupIndices.Find( InGroup ) )
+	{
+		return *Index;
+	}
+
+	CountGrowth( Groups, Groups.Num() + 1 );
+	const int32 Index = Groups.AddDefaulted();
+	Groups[ Index ].Name = InGroup;
+	const SIZE_T MapSize = GroupIndices.GetAllocatedSize();
+	GroupIndices.Add( InGroup, Index );
+	if ( GroupIndices.GetAllocatedSize() != MapSize )
+	{
+		PendingAllocations.ContainerGrowths++;
+	}
+	return Index;
+}
+
+
+const FBUITweenGroup* FBUITweenManager::FindGroup( FName InGroup ) const
+{
+	const int32* Index = GroupIndices.Find( InGroup );
+	return Index ? &Groups[ *Index ] : nullptr;
+}
+
+
+void FBUITweenManager::SetGroupTimeScale( FName InGroup, float InTimeScale )
+{
+	Groups[ FindOrAddGroup( InGroup ) ].TimeScale = FMath::Max( InTimeScale, 0.0f );
+}
+
+
+float FBUITweenManager::GetGroupTimeScale( FName InGroup ) const
+{
+	const FBUITweenGroup* Group = FindGroup( InGroup );
+	return Group ? Group->TimeScale : 1.0f;
+}
+
+
+void FBUITweenManager::SetGroupPaused( FName InGroup, bool bInPaused )
+{
+	Groups[ FindOrAddGroup( InGroup ) ].bIsPaused = bInPaused;
+}
+
+
+bool FBUITweenManager::IsGroupPaused( FName InGroup ) const
+{
+	const FBUITweenGroup* Group = FindGroup( InGroup );
+	return Group && Group->bIsPaused;
+}
+
+
+void FBUITweenManager::SetGroupCulling( FName InGroup, EBUITweenCulling InCulling )
+{
+	// Group on a group would refer to itself
+	Groups[ FindOrAddGroup( InGroup ) ].Culling = InCulling == EBUITweenCulling::Group ? EBUITweenCulling::None : InCulling;
+}
+
+
+EBUITweenCulling FBUITweenManager::GetGroupCulling( FName InGroup ) const
+{
+	const FBUITweenGroup* Group = FindGroup( InGroup );
+	return Group ? Group->Culling : EBUITweenCulling::None;
+}
+
+
+int32 FBUITweenManager::CancelGroup( FName InGroup )
+{
+	const int32* GroupIndex = GroupIndices.Find( InGroup );
+	if ( GroupIndex == nullptr )
+	{
+		return 0;
+	}
+
+	// Release only flags rows, so the streams don't change under us
+	int32 NumRemoved = 0;
+	FBUITweenGroup& Group = Groups[ *GroupIndex ];
+	for ( const FBUITweenTimingStream* Timings : { &Group.Prepared, &Group.Delayed, &Group.Timings } )
+	{
+		for ( int32 Row = 0; Row < Timings->Num(); ++Row )
+		{
+			if ( !EnumHasAnyFlags( Timings->Flags[ Row ], EBUITweenTimingFlags::Removed )
+				&& Release( Pool.GetHandleAt( Timings->SlotIndex[ Row ] ) ) )
+			{
+				NumRemoved++;
+			}
+		}
+	}
+	return NumRemoved;
+}
+
+
+void FBUITweenManager::CompleteGroup( FName InGroup )
+{
+	if ( const int32* GroupIndex = GroupIndices.Find( InGroup ) )
+	{
+		CompleteGroups( *GroupIndex );
+	}
+}
+
+
+int32 FBUITweenManager::GetGroupNum( FName InGroup ) const
+{
+	const FBUITweenGroup* Group = FindGroup( InGroup );
+	if ( Group == nullptr )
+	{
+		return 0;
+	}
+
+	int32 Num = 0;
+	for ( int32 NumInSet : Group->NumPerSet )
+	{
+		Num += NumInSet;
+	}
+	return Num;
+}
+
+
+bool FBUITweenManager::GetIsTweening( UWidget* pInWidget ) const
+{
+	const FBUITweenWidgetEntry* Entry = WidgetTweens.Find( pInWidget );
+	return Entry != nullptr && !Entry->IsEmpty();
+}
+
+
+void FBUITweenManager::GetTweens( UWidget* pInWidget, TArray< FBUITweenHandle >& OutHandles ) const
+{
+	if ( const FBUITweenWidgetEntry* Entry = WidgetTweens.Find( pInWidget ) )
+	{
+		OutHandles.Append( Entry->Tweens );
+	}
+}
+
+
+void FBUITweenManager::GetTimelines( UWidget* pInWidget, TArray< FBUITweenTimelineHandle >& OutHandles ) const
+{
+	if ( const FBUITweenWidgetEntry* Entry = WidgetTweens.Find( pInWidget ) )
+	{
+		for ( const FBUITweenTimelineTrackRef& Ref : Entry->TimelineTracks )
+		{
+			OutHandles.Add( FBUITweenTimelineHandle( Ref.Timeline, const_cast< FBUITweenManager* >( this ) ) );
+		}
+	}
+}
+
+
+void FBUITweenManager::CompleteAll()
+{
+	CompleteGroups( INDEX_NONE );
+}
+
+
+void FBUITweenManager::CompleteGroups( int32 OnlyGroup )
+{
+	// Each pass finishes what the previous one's OnComplete callbacks began. A tween that begins itself
+	// again on complete would go on forever, so that gets cut off.
+	const int32 MaxPasses = 64;
+	for ( int32 Pass = 0; Pass < MaxPasses; ++Pass )
+	{
+		if ( !HasTweensToComplete( OnlyGroup ) )
+		{
+			return;
+		}
+		Tick( 0, true, OnlyGroup );
+	}
+
+	if ( HasTweensToComplete( OnlyGroup ) )
+	{
+		UE_LOG( LogBUITween, Warning, TEXT( "Completing tweens gave up after %d passes, OnComplete callbacks keep beginning new ones" ), MaxPasses );
+	}
+}
+
+
+bool FBUITweenManager::HasTweensToComplete( int32 OnlyGroup ) const
+{
+	for ( int32 GroupIndex = 0; GroupIndex < Groups.Num(); ++GroupIndex )
+	{
+		const FBUITweenGroup& Group = Groups[ GroupIndex ];
+		if ( ( OnlyGroup == INDEX_NONE || GroupIndex == OnlyGroup )
+			&& Group.NumPerSet[ (int32)EBUITweenTimingSet::Delayed ] + Group.NumPerSet[ (int32)EBUITweenTimingSet::Running ] > 0 )
+		{
+			return true;
+		}
+	}
+
+	if ( OnlyGroup == INDEX_NONE )
+	{
+		for ( const TUniquePtr< FBUITweenTimelinePlayback >& Timeline : Timelines )
+		{
+			if ( !Timeline->bIsFinished )
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+
+void FBUITweenManager::StartAllDelayed( int32 GroupIndex )
+{
+	// Both the scheduled tweens and paused ones, which are waiting outside the heap
+	FBUITweenGroup& Group = Groups[ GroupIndex ];
+	for ( int32 Row = 0; Row < Group.Delayed.Num(); ++Row )
+	{
+		if ( !EnumHasAnyFlags( Group.Delayed.Flags[ Row ], EBUITweenTimingFlags::Removed ) )
+		{
+			const int32 NewRow = MoveTiming( Pool.GetHandleAt( Group.Delayed.SlotIndex[ Row ] ), EBUITweenTimingSet::Running );
+			Group.Timings.Delay[ NewRow ] = 0;
+		}
+	}
+	Group.DelayedStarts.Reset();
+}
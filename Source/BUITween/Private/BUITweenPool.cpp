@@ -0,0 +1,100 @@
+#include "BUITweenPool.h"
+
+FBUITweenHandle FBUITweenPool::Add( FBUITweenInstance&& InInstance )
+{
+	int32 Index;
+	if ( FreeSlots.Num() > 0 )
+	{
+		Index = FreeSlots.Pop( false );
+	}
+	else
+	{
+		if ( NumSlots == Chunks.Num() * SlotsPerChunk )
+		{
+			Chunks.Add( MakeUnique<FSlot[]>( SlotsPerChunk ) );
+			NumGrowths++;
+		}
+		Index = NumSlots++;
+	}
+
+	FSlot& Slot = GetSlot( Index );
+	// Free slots have an even generation, bump it to mark the slot as used
+	Slot.Generation++;
+	Slot.Instance = MoveTemp( InInstance );
+	Slot.TimingRow = INDEX_NONE;
+	Slot.TimingGroup = 0;
+	Slot.TimingSet = EBUITweenTimingSet::Prepared;
+	NumUsed++;
+
+	return FBUITweenHandle( Index, Slot.Generation, Owner );
+}
+
+
+bool FBUITweenPool::Remove( FBUITweenHandle Handle )
+{
+	if ( Get( Handle ) == nullptr )
+	{
+		return false;
+	}
+
+	FSlot& Slot = GetSlot( Handle.GetIndex() );
+	Slot.Generation++;
+	if ( SlotsPendingRelease.Num() == SlotsPendingRelease.Max() )
+	{
+		NumGrowths++;
+	}
+	SlotsPendingRelease.Add( Handle.GetIndex() );
+	NumUsed--;
+	return true;
+}
+
+
+void FBUITweenPool::ReleasePendingSlots()
+{
+	if ( FreeSlots.Num() + SlotsPendingRelease.Num() > FreeSlots.Max() )
+	{
+		NumGrowths++;
+	}
+	for ( int32 Index : SlotsPendingRelease )
+	{
+		// Drop the delegates and widget reference now that nothing can be running on this instance
+		GetSlot( Index ).Instance = FBUITweenInstance();
+		FreeSlots.Add( Index );
+	}
+	SlotsPendingRelease.Reset();
+}
+
+
+void FBUITweenPool::Reserve( int32 NumTweens )
+{
+	const int32 NumChunks = FMath::DivideAndRoundUp( NumTweens, (int32)SlotsPerChunk );
+	Chunks.Reserve( NumChunks );
+	while ( Chunks.Num() < NumChunks )
+	{
+		Chunks.Add( MakeUnique<FSlot[]>( SlotsPerChunk ) );
+	}
+
+	const int32 Capacity = Chunks.Num() * SlotsPerChunk;
+	FreeSlots.Reserve( Capacity );
+	SlotsPendingRelease.Reserve( Capacity );
+}
+
+
+void FBUITweenPool::Empty()
+{
+	// Slots and their generations are kept, so handles from before stay stale instead of matching whatever
+	// is created in their slot next
+	FreeSlots.Reset();
+	for ( int32 Index = NumSlots - 1; Index >= 0; --Index )
+	{
+		FSlot& Slot = GetSlot( Index );
+		if ( Slot.Generation & 1 )
+		{
+			Slot.Generation++;
+		}
+		Slot.Instance = FBUITweenInstance();
+		FreeSlots.Add( Index );
+	}
+	SlotsPendingRelease.Reset();
+	NumUsed = 0;
+}
@@ -0,0 +1,71 @@
+#include "BUITweenStats.h"
+#include "Components/Widget.h"
+#include "HAL/PlatformTime.h"
+
+DEFINE_STAT( STAT_BUITweenUpdate );
+DEFINE_STAT( STAT_BUITweenAdvance );
+DEFINE_STAT( STAT_BUITweenEase );
+DEFINE_STAT( STAT_BUITweenCompute );
+DEFINE_STAT( STAT_BUITweenApply );
+DEFINE_STAT( STAT_BUITweenApplyColor );
+DEFINE_STAT( STAT_BUITweenApplyVisibility );
+DEFINE_STAT( STAT_BUITweenApplyLayout );
+DEFINE_STAT( STAT_BUITweenApplyRender );
+DEFINE_STAT( STAT_BUITweenCallbacks );
+DEFINE_STAT( STAT_BUITweenCompact );
+
+DEFINE_STAT( STAT_BUITweenPrepared );
+DEFINE_STAT( STAT_BUITweenDelayed );
+DEFINE_STAT( STAT_BUITweenRunning );
+DEFINE_STAT( STAT_BUITweenCompleted );
+DEFINE_STAT( STAT_BUITweenCulled );
+DEFINE_STAT( STAT_BUITweenOverBudget );
+DEFINE_STAT( STAT_BUITweenSetterCalls );
+DEFINE_STAT( STAT_BUITweenSetterCallsSkipped );
+DEFINE_STAT( STAT_BUITweenAllocations );
+
+UE_TRACE_CHANNEL_DEFINE( BUITweenChannel );
+
+UE_TRACE_EVENT_BEGIN( BUITween, TweenStart )
+	UE_TRACE_EVENT_FIELD( uint64, Cycle )
+	UE_TRACE_EVENT_FIELD( uint32, Sequence )
+	UE_TRACE_EVENT_FIELD( float, Duration )
+	UE_TRACE_EVENT_FIELD( UE::Trace::WideString, WidgetName )
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN( BUITween, TweenComplete )
+	UE_TRACE_EVENT_FIELD( uint64, Cycle )
+	UE_TRACE_EVENT_FIELD( uint32, Sequence )
+	UE_TRACE_EVENT_FIELD( UE::Trace::WideString, WidgetName )
+UE_TRACE_EVENT_END()
+
+namespace BUITweenTrace
+{
+	void OutputTweenStart( const UWidget* Widget, uint32 Sequence, float Duration )
+	{
+		// Skip building the name unless someone is recording
+		if ( !UE_TRACE_CHANNELEXPR_IS_ENABLED( BUITweenChannel ) )
+		{
+			return;
+		}
+		const FString WidgetName = Widget ? Widget->GetPathName() : FString();
+		UE_TRACE_LOG( BUITween, TweenStart, BUITweenChannel )
+			<< TweenStart.Cycle( FPlatformTime::Cycles64() )
+			<< TweenStart.Sequence( Sequence )
+			<< TweenStart.Duration( Duration )
+			<< TweenStart.WidgetName( *WidgetName, WidgetName.Len() );
+	}
+
+	void OutputTweenComplete( const UWidget* Widget, uint32 Sequence )
+	{
+		if ( !UE_TRACE_CHANNELEXPR_IS_ENABLED( BUITweenChannel ) )
+		{
+			return;
+		}
+		const FString WidgetName = Widget ? Widget->GetPathName() : FString();
+		UE_TRACE_LOG( BUITween, TweenComplete, BUITweenChannel )
+			<< TweenComplete.Cycle( FPlatformTime::Cycles64() )
+			<< TweenComplete.Sequence( Sequence )
+			<< TweenComplete.WidgetName( *WidgetName, WidgetName.Len() );
+	}
+}
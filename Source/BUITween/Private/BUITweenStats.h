@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+class UWidget;
+
+// "stat BUITween" in the console
+DECLARE_STATS_GROUP( TEXT( "BUITween" ), STATGROUP_BUITween, STATCAT_Advanced );
+
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Update" ), STAT_BUITweenUpdate, STATGROUP_BUITween, BUITWEEN_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Advance Time" ), STAT_BUITweenAdvance, STATGROUP_BUITween, BUITWEEN_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Easing" ), STAT_BUITweenEase, STATGROUP_BUITween, BUITWEEN_API );
+// Advance, easing and evaluation together, when they run in parallel
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Parallel Compute" ), STAT_BUITweenCompute, STATGROUP_BUITween, BUITWEEN_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Apply" ), STAT_BUITweenApply, STATGROUP_BUITween, BUITWEEN_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Apply Color" ), STAT_BUITweenApplyColor, STATGROUP_BUITween, BUITWEEN_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Apply Visibility" ), STAT_BUITweenApplyVisibility, STATGROUP_BUITween, BUITWEEN_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Apply Layout" ), STAT_BUITweenApplyLayout, STATGROUP_BUITween, BUITWEEN_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Apply Render Transform/Opacity" ), STAT_BUITweenApplyRender, STATGROUP_BUITween, BUITWEEN_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Callbacks" ), STAT_BUITweenCallbacks, STATGROUP_BUITween, BUITWEEN_API );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Compact" ), STAT_BUITweenCompact, STATGROUP_BUITween, BUITWEEN_API );
+
+// Tweens in each state across every group, see FBUITweenGroup. Completed counts the ones that finished in
+// the last update.
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Prepared Tweens" ), STAT_BUITweenPrepared, STATGROUP_BUITween, BUITWEEN_API );
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Delayed Tweens" ), STAT_BUITweenDelayed, STATGROUP_BUITween, BUITWEEN_API );
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Running Tweens" ), STAT_BUITweenRunning, STATGROUP_BUITween, BUITWEEN_API );
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Completed Tweens" ), STAT_BUITweenCompleted, STATGROUP_BUITween, BUITWEEN_API );
+// Tweens that advanced in the last update but weren't applied because their widget couldn't be seen.
+// Staggered tweens count once per culled widget.
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Culled Tweens" ), STAT_BUITweenCulled, STATGROUP_BUITween, BUITWEEN_API );
+// Reduced-rate tweens left for a later update because the last one ran out of UBUITweenSettings::UpdateBudgetMs
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Over Budget Tweens" ), STAT_BUITweenOverBudget, STATGROUP_BUITween, BUITWEEN_API );
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Setter Calls" ), STAT_BUITweenSetterCalls, STATGROUP_BUITween, BUITWEEN_API );
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Setter Calls Skipped" ), STAT_BUITweenSetterCallsSkipped, STATGROUP_BUITween, BUITWEEN_API );
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Allocations" ), STAT_BUITweenAllocations, STATGROUP_BUITween, BUITWEEN_API );
+
+// Enable with -trace=cpu,BUITween. Adds CPU scopes for each update phase and TweenStart/TweenComplete events
+// naming the widget, so Insights can show whose animations a frame is spent on.
+UE_TRACE_CHANNEL_EXTERN( BUITweenChannel, BUITWEEN_API );
+
+// Stat cycle counter and trace CPU scope in one
+#define BUITWEEN_SCOPE_CYCLE_COUNTER( Stat ) \
+	SCOPE_CYCLE_COUNTER( Stat ); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL( Stat, BUITweenChannel )
+
+namespace BUITweenTrace
+{
+	// Sequence is the tween's creation order, it pairs up start and complete events for one tween
+	BUITWEEN_API void OutputTweenStart( const UWidget* Widget, uint32 Sequence, float Duration );
+	BUITWEEN_API void OutputTweenComplete( const UWidget* Widget, uint32 Sequence );
+}
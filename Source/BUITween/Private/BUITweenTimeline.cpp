@@ -0,0 +1,65 @@
+#include "BUITweenTimeline.h"
+#include "BUITweenManager.h"
+
+bool FBUITweenTimelineHandle::IsPlaying() const
+{
+	return Manager ? Manager->IsTimelinePlaying( *this ) : false;
+}
+
+
+bool FBUITweenTimelineHandle::Stop()
+{
+	return Manager ? Manager->StopTimeline( *this ) : false;
+}
+
+
+FBUITweenTimeline& FBUITweenTimeline::Then( UWidget* pInWidget, float InDuration, FSetup Setup )
+{
+	StepStart = End;
+	AddTrack( pInWidget, StepStart, InDuration, Setup );
+	return *this;
+}
+
+
+FBUITweenTimeline& FBUITweenTimeline::With( UWidget* pInWidget, float InDuration, FSetup Setup )
+{
+	AddTrack( pInWidget, StepStart, InDuration, Setup );
+	return *this;
+}
+
+
+FBUITweenTimeline& FBUITweenTimeline::Stagger( TArrayView< UWidget* > Widgets, float InDuration, float InInterval, FSetup Setup )
+{
+	StepStart = End;
+	Tracks.Reserve( Tracks.Num() + Widgets.Num() );
+	for ( int32 i = 0; i < Widgets.Num(); ++i )
+	{
+		AddTrack( Widgets[ i ], StepStart + i * InInterval, InDuration, Setup );
+	}
+	return *this;
+}
+
+
+FBUITweenTimeline& FBUITweenTimeline::Wait( float InSeconds )
+{
+	End += FMath::Max( InSeconds, 0.0f );
+	return *this;
+}
+
+
+FBUITweenTimelineHandle FBUITweenTimeline::Play()
+{
+	return Manager ? Manager->Play( MoveTemp( *this ) ) : FBUITweenTimelineHandle();
+}
+
+
+void FBUITweenTimeline::AddTrack( UWidget* pInWidget, float InStart, float InDuration, FSetup& Setup )
+{
+	FBUITweenTimelineTrack& Track = Tracks.AddDefaulted_GetRef();
+	Track.Start = InStart;
+	Track.Duration = FMath::Max( InDuration, 0.0f );
+	Track.Instance = FBUITweenInstance( pInWidget );
+	Setup( Track.Instance );
+
+	End = FMath::Max( End, InStart + Track.Duration );
+}
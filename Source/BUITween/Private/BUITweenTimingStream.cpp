@@ -0,0 +1,142 @@
+#include "BUITweenTimingStream.h"
+
+void FBUITweenTimingStream::Advance( int32 BeginRow, int32 EndRow, float DeltaTime )
+{
+	for ( int32 Row = BeginRow; Row < EndRow; ++Row )
+	{
+		EBUITweenTimingFlags& RowFlags = Flags[ Row ];
+		if ( EnumHasAnyFlags( RowFlags, EBUITweenTimingFlags::Paused | EBUITweenTimingFlags::Complete | EBUITweenTimingFlags::Removed ) )
+		{
+			continue;
+		}
+
+		float Step = DeltaTime;
+		const float Interval = UpdateInterval[ Row ];
+		if ( Interval > 0 )
+		{
+			// Bank the time, the last step is never held back so the tween still ends on time
+			PendingTime[ Row ] += DeltaTime;
+			UpdateCountdown[ Row ] -= DeltaTime;
+			if ( UpdateCountdown[ Row ] > 0 && Alpha[ Row ] + PendingTime[ Row ] < Duration[ Row ] )
+			{
+				continue;
+			}
+			UpdateCountdown[ Row ] = FMath::Max( UpdateCountdown[ Row ] + Interval, 0.0f );
+			Step = PendingTime[ Row ];
+			PendingTime[ Row ] = 0;
+		}
+
+		float& RowAlpha = Alpha[ Row ];
+		RowAlpha += Step;
+		if ( RowAlpha >= Duration[ Row ] )
+		{
+			RowAlpha = Duration[ Row ];
+			RowFlags |= EBUITweenTimingFlags::Complete;
+		}
+		RowFlags |= EBUITweenTimingFlags::NeedsApply;
+	}
+}
+
+void FBUITweenTimingStream::Finish( int32 BeginRow, int32 EndRow )
+{
+	for ( int32 Row = BeginRow; Row < EndRow; ++Row )
+	{
+		if ( EnumHasAnyFlags( Flags[ Row ], EBUITweenTimingFlags::Removed ) )
+		{
+			continue;
+		}
+		Alpha[ Row ] = Duration[ Row ];
+		PendingTime[ Row ] = 0;
+		Flags[ Row ] |= EBUITweenTimingFlags::Complete | EBUITweenTimingFlags::NeedsApply;
+	}
+}
+
+void FBUITweenTimingStream::EaseRows( int32 BeginRow, int32 EndRow )
+{
+	for ( int32 Row = BeginRow; Row < EndRow; ++Row )
+	{
+		if ( !EnumHasAnyFlags( Flags[ Row ], EBUITweenTimingFlags::NeedsApply ) )
+		{
+			continue;
+		}
+		EasedAlpha[ Row ] = EaseAt( Row, Alpha[ Row ] / Duration[ Row ] );
+	}
+}
+
+void FBUITweenTimingStream::Ease( int32 NumRows )
+{
+	int32 NumPerType[ FBUIEasing::NumEasingTypes ] = { 0 };
+
+	// Count the rows in each bucket, and get the odd ones with their own easing param out of the way
+	for ( int32 Row = 0; Row < NumRows; ++Row )
+	{
+		const EBUITweenTimingFlags RowFlags = Flags[ Row ];
+		if ( !EnumHasAnyFlags( RowFlags, EBUITweenTimingFlags::NeedsApply ) )
+		{
+			continue;
+		}
+		if ( EasingTable[ Row ] )
+		{
+			EasedAlpha[ Row ] = EasingTable[ Row ]->Sample( Alpha[ Row ] / Duration[ Row ] );
+			continue;
+		}
+		if ( EnumHasAnyFlags( RowFlags, EBUITweenTimingFlags::HasEasingParam ) )
+		{
+			EasedAlpha[ Row ] = EasingFunction[ Row ]( Alpha[ Row ] / Duration[ Row ], EasingParam[ Row ], EasingPeriod[ Row ] );
+			continue;
+		}
+		NumPerType[ (int32)EasingType[ Row ] ]++;
+	}
+
+	int32 BucketStart[ FBUIEasing::NumEasingTypes ];
+	int32 NumBatched = 0;
+	for ( int32 Type = 0; Type < FBUIEasing::NumEasingTypes; ++Type )
+	{
+		BucketStart[ Type ] = NumBatched;
+		NumBatched += NumPerType[ Type ];
+	}
+	if ( NumBatched == 0 )
+	{
+		return;
+	}
+
+	// Gather time and duration into contiguous per-type runs
+	if ( NumBatched > BatchRows.Max() )
+	{
+		NumGrowths++;
+	}
+	BatchRows.SetNumUninitialized( NumBatched, false );
+	BatchTime.SetNumUninitialized( NumBatched, false );
+	BatchDuration.SetNumUninitialized( NumBatched, false );
+	BatchOut.SetNumUninitialized( NumBatched, false );
+
+	int32 BucketCursor[ FBUIEasing::NumEasingTypes ];
+	FMemory::Memcpy( BucketCursor, BucketStart, sizeof( BucketStart ) );
+	for ( int32 Row = 0; Row < NumRows; ++Row )
+	{
+		if ( ( Flags[ Row ] & ( EBUITweenTimingFlags::NeedsApply | EBUITweenTimingFlags::HasEasingParam ) ) != EBUITweenTimingFlags::NeedsApply
+			|| EasingTable[ Row ] )
+		{
+			continue;
+		}
+		const int32 BatchIndex = BucketCursor[ (int32)EasingType[ Row ] ]++;
+		BatchRows[ BatchIndex ] = Row;
+		BatchTime[ BatchIndex ] = Alpha[ Row ];
+		BatchDuration[ BatchIndex ] = Duration[ Row ];
+	}
+
+	for ( int32 Type = 0; Type < FBUIEasing::NumEasingTypes; ++Type )
+	{
+		if ( NumPerType[ Type ] > 0 )
+		{
+			const int32 Start = BucketStart[ Type ];
+			FBUIEasing::EaseBatch( (EBUIEasingType)Type, &BatchTime[ Start ], &BatchDuration[ Start ], &BatchOut[ Start ], NumPerType[ Type ] );
+		}
+	}
+
+	// Scatter back
+	for ( int32 BatchIndex = 0; BatchIndex < NumBatched; ++BatchIndex )
+	{
+		EasedAlpha[ BatchRows[ BatchIndex ] ] = BatchOut[ BatchIndex ];
+	}
+}
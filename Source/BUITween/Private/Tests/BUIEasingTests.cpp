@@ -0,0 +1,106 @@
+#include "Misc/AutomationTest.h"
+#include "BUIEasing.h"
+#include "BUIEasingTable.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUIEasingBatchTest, "BUITween.Easing.BatchMatchesScalar",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUIEasingBatchTest::RunTest( const FString& Parameters )
+{
+	// An odd count leaves a tail that doesn't fill a register, and two durations check the time / duration
+	// normalisation of the vector paths
+	constexpr int32 NumSamples = 1001;
+	const float Durations[] = { 1.0f, 0.37f };
+
+	TArray< float > Time;
+	TArray< float > Duration;
+	TArray< float > Out;
+	Time.SetNumUninitialized( NumSamples );
+	Duration.SetNumUninitialized( NumSamples );
+	Out.SetNumUninitialized( NumSamples );
+
+	for ( const float D : Durations )
+	{
+		for ( int32 i = 0; i < NumSamples; ++i )
+		{
+			Time[ i ] = D * i / ( NumSamples - 1 );
+			Duration[ i ] = D;
+		}
+
+		for ( int32 Type = 0; Type < FBUIEasing::NumEasingTypes; ++Type )
+		{
+			FBUIEasing::EaseBatch( (EBUIEasingType)Type, Time.GetData(), Duration.GetData(), Out.GetData(), NumSamples );
+
+			float MaxError = 0;
+			for ( int32 i = 0; i < NumSamples; ++i )
+			{
+				MaxError = FMath::Max( MaxError, FMath::Abs( Out[ i ] - FBUIEasing::Ease( (EBUIEasingType)Type, Time[ i ], D ) ) );
+			}
+			TestTrue( FString::Printf( TEXT( "Easing type %d over duration %f is within EaseBatchTolerance, off by %g" ), Type, D, MaxError ),
+				MaxError <= FBUIEasing::EaseBatchTolerance );
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUIEasingTableTest, "BUITween.Easing.TablesMatchCurves",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUIEasingTableTest::RunTest( const FString& Parameters )
+{
+	// Baked with the largest resolution the settings allow, so every curve can reach the error bound and a
+	// miss points at Sample rather than at the resolution cap. The sweep doesn't line up with the samples.
+	const UBUITweenSettings* Settings = GetDefault<UBUITweenSettings>();
+	const float MaxError = Settings->MaxEasingTableError;
+	constexpr int32 NumProbes = 10007;
+	const EBUIEasingTableInterpolation Interpolations[] = { EBUIEasingTableInterpolation::Linear, EBUIEasingTableInterpolation::Hermite };
+
+	for ( const EBUIEasingTableInterpolation Interpolation : Interpolations )
+	{
+		for ( int32 Type = 0; Type < FBUIEasing::NumEasingTypes; ++Type )
+		{
+			auto EaseFn = [Type]( float t ) { return FBUIEasing::Ease( (EBUIEasingType)Type, t ); };
+			FBUIEasingTable Table;
+			Table.Bake( EaseFn, Interpolation, Settings->EasingTableResolution, 65536, MaxError );
+
+			float WorstError = 0;
+			for ( int32 i = 0; i <= NumProbes; ++i )
+			{
+				const float t = (float)i / NumProbes;
+				WorstError = FMath::Max( WorstError, FMath::Abs( Table.Sample( t ) - EaseFn( t ) ) );
+			}
+			TestTrue( FString::Printf( TEXT( "%s table for easing type %d at %d samples is within MaxEasingTableError, off by %g" ),
+				Interpolation == EBUIEasingTableInterpolation::Linear ? TEXT( "Linear" ) : TEXT( "Hermite" ), Type, Table.GetResolution(), WorstError ),
+				WorstError <= MaxError );
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUIEasingTableTrimTest, "BUITween.Easing.TrimKeepsTablesInUse",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUIEasingTableTrimTest::RunTest( const FString& Parameters )
+{
+	// Elastic tables are per duration, so every one of these is a new table
+	FBUIEasingTableCache::Empty();
+	FBUIEasingTablePtr InUse = FBUIEasingTableCache::GetForTween( EBUIEasingType::OutElastic, 0.5f );
+	const float InUseValue = InUse->Sample( 0.3f );
+	for ( int32 i = 1; i <= 200; ++i )
+	{
+		FBUIEasingTableCache::GetForTween( EBUIEasingType::OutElastic, 0.5f + i * 0.01f );
+	}
+	TestTrue( TEXT( "Unused tables are trimmed as the cache grows" ), FBUIEasingTableCache::Num() < 200 );
+
+	FBUIEasingTableCache::Trim();
+	TestEqual( TEXT( "Trim keeps only the table in use" ), FBUIEasingTableCache::Num(), 1 );
+	TestTrue( TEXT( "Table in use is still the one handed out" ), FBUIEasingTableCache::GetForTween( EBUIEasingType::OutElastic, 0.5f ) == InUse );
+
+	FBUIEasingTableCache::Empty();
+	TestEqual( TEXT( "Table in use survives Empty" ), InUse->Sample( 0.3f ), InUseValue );
+	return true;
+}
+
+#endif
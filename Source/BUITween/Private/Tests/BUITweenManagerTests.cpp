@@ -0,0 +1,644 @@
+#include "Misc/AutomationTest.h"
+#include "BUITweenManager.h"
+#include "BUITweenSettings.h"
+#include "Components/Image.h"
+#include "Curves/CurveFloat.h"
+#include "UObject/Package.h"
+#include "Widgets/Layout/SBox.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Session Frontend > Automation, or "Automation RunTests BUITween" in the console
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenCompleteAllPausedTest, "BUITween.Manager.CompleteAllPausedGroups",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenCompleteAllPausedTest::RunTest( const FString& Parameters )
+{
+	FBUITweenManager Manager;
+	UImage* Paused = NewObject< UImage >( GetTransientPackage() );
+	UImage* Stopped = NewObject< UImage >( GetTransientPackage() );
+
+	int32 NumCompleted = 0;
+	Manager.Create( Paused, 1.0f, 0.0f, false, TEXT( "Paused" ) ).ToOpacity( 0.5f ).OnComplete( [&NumCompleted]( UWidget* ) { NumCompleted++; } ).Begin();
+	Manager.Create( Stopped, 1.0f, 0.0f, false, TEXT( "Stopped" ) ).ToOpacity( 0.25f ).OnComplete( [&NumCompleted]( UWidget* ) { NumCompleted++; } ).Begin();
+	Manager.SetGroupPaused( TEXT( "Paused" ), true );
+	Manager.SetGroupTimeScale( TEXT( "Stopped" ), 0.0f );
+
+	Manager.CompleteAll();
+
+	TestEqual( TEXT( "OnComplete fired for both tweens" ), NumCompleted, 2 );
+	TestFalse( TEXT( "Tween in a paused group finished" ), Manager.GetIsTweening( Paused ) );
+	TestFalse( TEXT( "Tween in a group with time scale 0 finished" ), Manager.GetIsTweening( Stopped ) );
+	TestEqual( TEXT( "Paused group's tween reached its end value" ), Paused->GetRenderOpacity(), 0.5f );
+	TestEqual( TEXT( "Stopped group's tween reached its end value" ), Stopped->GetRenderOpacity(), 0.25f );
+	TestTrue( TEXT( "Group stays paused" ), Manager.IsGroupPaused( TEXT( "Paused" ) ) );
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenClearTimelineTrackTest, "BUITween.Manager.ClearStopsTimelineTracks",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenClearTimelineTrackTest::RunTest( const FString& Parameters )
+{
+	FBUITweenManager Manager;
+	UImage* Image = NewObject< UImage >( GetTransientPackage() );
+
+	bool bCompleted = false;
+	FBUITweenTimelineHandle Timeline = Manager.Sequence()
+		.Then( Image, 1.0f, [&bCompleted]( FBUITweenInstance& T ) { T.ToOpacity( 0.5f ).OnComplete( [&bCompleted]( UWidget* ) { bCompleted = true; } ); } )
+		.Play();
+	Manager.Update( 0.1f );
+
+	TestTrue( TEXT( "Playing track counts as tweening" ), Manager.GetIsTweening( Image ) );
+	TArray< FBUITweenTimelineHandle > Timelines;
+	Manager.GetTimelines( Image, Timelines );
+	TestTrue( TEXT( "GetTimelines lists the timeline" ), Timelines.Num() == 1 && Timelines[ 0 ].GetId() == Timeline.GetId() );
+
+	const float OpacityAtClear = Image->GetRenderOpacity();
+	TestEqual( TEXT( "Clear stops the track" ), Manager.Clear( Image ), 1 );
+	TestFalse( TEXT( "Stopped track no longer tweening" ), Manager.GetIsTweening( Image ) );
+
+	Manager.Update( 1.0f );
+	TestEqual( TEXT( "Stopped track no longer writes" ), Image->GetRenderOpacity(), OpacityAtClear );
+	TestFalse( TEXT( "Stopped track doesn't fire OnComplete" ), bCompleted );
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenBeginInCallbackTest, "BUITween.Manager.BeginInCallbackKeepsLayers",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenBeginInCallbackTest::RunTest( const FString& Parameters )
+{
+	FBUITweenManager Manager;
+	UImage* Layered = NewObject< UImage >( GetTransientPackage() );
+	UImage* Other = NewObject< UImage >( GetTransientPackage() );
+	UImage* Started = NewObject< UImage >( GetTransientPackage() );
+
+	// Two additive layers on one widget, with a callback beginning another tween applied between them
+	FBUITweenHandle Deferred = Manager.Create( Started, 1.0f ).ToOpacity( 0.5f );
+	Manager.Create( Layered, 1.0f, 0.0f, true ).Easing( EBUIEasingType::Linear ).ToTranslation( 10, 0 ).Begin();
+	Manager.Create( Other, 1.0f ).ToOpacity( 0.5f ).OnStart( [Deferred]( UWidget* ) mutable { Deferred.Begin(); } ).Begin();
+	Manager.Create( Layered, 1.0f, 0.0f, true ).Easing( EBUIEasingType::Linear ).ToTranslation( 0, 20 ).Begin();
+
+	Manager.Update( 0.5f );
+
+	const FVector2D Translation = Layered->GetRenderTransform().Translation;
+	TestEqual( TEXT( "First layer survives the callback" ), Translation.X, 5.0f, 0.01f );
+	TestEqual( TEXT( "Second layer is applied" ), Translation.Y, 10.0f, 0.01f );
+	TestTrue( TEXT( "Tween begun in the callback is running" ), Manager.GetIsTweening( Started ) );
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenAllocationCountersTest, "BUITween.Manager.AllocationCounters",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenAllocationCountersTest::RunTest( const FString& Parameters )
+{
+	FBUITweenManager Manager;
+	UImage* Image = NewObject< UImage >( GetTransientPackage() );
+
+	// Within InitialTweenCapacity, creating and finishing tweens settles at no allocations
+	int32 NumCompleted = 0;
+	for ( int32 Frame = 0; Frame < 4; ++Frame )
+	{
+		Manager.Create( Image, 0.1f ).ToOpacity( 0.5f ).OnComplete( [&NumCompleted]( UWidget* ) { NumCompleted++; } ).Begin();
+		Manager.Update( 0.2f );
+	}
+	TestEqual( TEXT( "Every tween completed" ), NumCompleted, 4 );
+	TestEqual( TEXT( "Steady state doesn't allocate" ), Manager.GetAllocationCounters().Num(), 0 );
+
+	// Delegates are bound on the heap whether they are copied or moved in
+	FBUITweenSignature Copied = FBUITweenSignature::CreateLambda( [&NumCompleted]( UWidget* ) { NumCompleted++; } );
+	Manager.Create( Image, 0.1f ).ToOpacity( 0.5f ).OnComplete( Copied ).Begin();
+	Manager.Update( 0.2f );
+	TestEqual( TEXT( "Copied delegate is counted" ), Manager.GetAllocationCounters().HeapCallbacks, 1 );
+
+	Manager.Create( Image, 0.1f ).ToOpacity( 0.5f ).OnComplete( FBUITweenSignature::CreateLambda( [&NumCompleted]( UWidget* ) { NumCompleted++; } ) ).Begin();
+	Manager.Update( 0.2f );
+	TestEqual( TEXT( "Moved delegate is counted" ), Manager.GetAllocationCounters().HeapCallbacks, 1 );
+	TestEqual( TEXT( "Both delegates fired" ), NumCompleted, 6 );
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenFixedStepTest, "BUITween.Manager.FixedStepMatchesManualUpdates",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenFixedStepTest::RunTest( const FString& Parameters )
+{
+	const float FixedStep = 0.1f;
+	FBUITweenManager Manual;
+	FBUITweenManager Stepped;
+	FBUITweenManager Seeked;
+	Stepped.SetFixedStep( FixedStep, 8 );
+	Seeked.SetFixedStep( FixedStep, 8 );
+
+	UImage* ManualImage = NewObject< UImage >( GetTransientPackage() );
+	UImage* SteppedImage = NewObject< UImage >( GetTransientPackage() );
+	UImage* SeekedImage = NewObject< UImage >( GetTransientPackage() );
+	Manual.Create( ManualImage, 1.0f ).Easing( EBUIEasingType::InOutQuad ).ToOpacity( 0.0f ).ToTranslation( 100, 50 ).Begin();
+	Stepped.Create( SteppedImage, 1.0f ).Easing( EBUIEasingType::InOutQuad ).ToOpacity( 0.0f ).ToTranslation( 100, 50 ).Begin();
+	Seeked.Create( SeekedImage, 1.0f ).Easing( EBUIEasingType::InOutQuad ).ToOpacity( 0.0f ).ToTranslation( 100, 50 ).Begin();
+
+	// Uneven frames add up to five whole steps plus a remainder that is carried, not run
+	for ( int32 Update = 0; Update < 5; ++Update )
+	{
+		Manual.Update( FixedStep );
+	}
+	TestEqual( TEXT( "Substeps run for whole steps only" ), Stepped.Step( 0.25f ) + Stepped.Step( 0.17f ) + Stepped.Step( 0.13f ), 5 );
+	TestEqual( TEXT( "SeekTo runs one update per step" ), Seeked.SeekTo( 0.5 ), 5 );
+
+	TestEqual( TEXT( "Step opacity matches manual updates" ), SteppedImage->GetRenderOpacity(), ManualImage->GetRenderOpacity() );
+	TestEqual( TEXT( "Step translation matches manual updates" ), SteppedImage->GetRenderTransform().Translation.X, ManualImage->GetRenderTransform().Translation.X );
+	TestEqual( TEXT( "SeekTo opacity matches manual updates" ), SeekedImage->GetRenderOpacity(), ManualImage->GetRenderOpacity() );
+	TestEqual( TEXT( "SeekTo translation matches manual updates" ), SeekedImage->GetRenderTransform().Translation.X, ManualImage->GetRenderTransform().Translation.X );
+	TestNotEqual( TEXT( "Tween is partway through" ), ManualImage->GetRenderOpacity(), 1.0f );
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenFixedStepBacklogTest, "BUITween.Manager.FixedStepDropsBacklog",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenFixedStepBacklogTest::RunTest( const FString& Parameters )
+{
+	FBUITweenManager Manager;
+	Manager.SetFixedStep( 0.1f, 2 );
+	UImage* Image = NewObject< UImage >( GetTransientPackage() );
+	Manager.Create( Image, 1.0f ).Easing( EBUIEasingType::Linear ).ToOpacity( 0.0f ).Begin();
+
+	// A one second hitch only runs MaxSubsteps, the rest is dropped rather than carried over
+	TestEqual( TEXT( "Hitch runs MaxSubsteps updates" ), Manager.Step( 1.0f ), 2 );
+	TestEqual( TEXT( "Time only moves by the steps run" ), Manager.GetTime(), 0.2, 0.0001 );
+	TestEqual( TEXT( "Tween only moves by the steps run" ), Image->GetRenderOpacity(), 0.8f, 0.0001f );
+	TestEqual( TEXT( "Dropped backlog doesn't run next call" ), Manager.Step( 0.05f ), 0 );
+	TestEqual( TEXT( "Remainder below a step is still carried" ), Manager.Step( 0.05f ), 1 );
+	TestEqual( TEXT( "Tween continues from where the hitch left it" ), Image->GetRenderOpacity(), 0.7f, 0.0001f );
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenCompleteAllChainTest, "BUITween.Manager.CompleteAllFinishesEverything",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenCompleteAllChainTest::RunTest( const FString& Parameters )
+{
+	FBUITweenManager Manager;
+	UImage* Chained = NewObject< UImage >( GetTransientPackage() );
+	UImage* Paused = NewObject< UImage >( GetTransientPackage() );
+	UImage* Delayed = NewObject< UImage >( GetTransientPackage() );
+
+	// Each OnComplete begins the next link, three deep
+	int32 NumLinks = 0;
+	TFunction< void( float ) > BeginLink;
+	BeginLink = [&]( float Opacity )
+	{
+		Manager.Create( Chained, 1.0f ).ToOpacity( Opacity ).OnComplete( [&, Opacity]( UWidget* )
+		{
+			NumLinks++;
+			if ( NumLinks < 3 )
+			{
+				BeginLink( Opacity * 0.5f );
+			}
+		} ).Begin();
+	};
+	BeginLink( 0.8f );
+
+	bool bPausedCompleted = false;
+	bool bDelayedStarted = false;
+	bool bDelayedCompleted = false;
+	FBUITweenHandle PausedHandle = Manager.Create( Paused, 1.0f ).ToOpacity( 0.5f ).OnComplete( [&bPausedCompleted]( UWidget* ) { bPausedCompleted = true; } ).Begin();
+	Manager.Create( Delayed, 1.0f, 10.0f ).ToOpacity( 0.25f )
+		.OnStart( [&bDelayedStarted]( UWidget* ) { bDelayedStarted = true; } )
+		.OnComplete( [&bDelayedCompleted]( UWidget* ) { bDelayedCompleted = true; } ).Begin();
+	Manager.Update( 0.1f );
+	PausedHandle.Pause();
+
+	Manager.CompleteAll();
+
+	TestEqual( TEXT( "Every link of the chain completed" ), NumLinks, 3 );
+	TestEqual( TEXT( "Chain ends on its last link's value" ), Chained->GetRenderOpacity(), 0.2f, 0.0001f );
+	TestFalse( TEXT( "Nothing left on the chained widget" ), Manager.GetIsTweening( Chained ) );
+	TestTrue( TEXT( "Individually paused tween completed" ), bPausedCompleted );
+	TestEqual( TEXT( "Paused tween reached its end value" ), Paused->GetRenderOpacity(), 0.5f );
+	TestTrue( TEXT( "Delayed tween started" ), bDelayedStarted );
+	TestTrue( TEXT( "Delayed tween completed" ), bDelayedCompleted );
+	TestEqual( TEXT( "Delayed tween reached its end value" ), Delayed->GetRenderOpacity(), 0.25f );
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenParallelOnStartTest, "BUITween.Manager.ParallelFirstFrameAfterOnStart",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenParallelOnStartTest::RunTest( const FString& Parameters )
+{
+	UBUITweenSettings* Settings = GetMutableDefault<UBUITweenSettings>();
+	const int32 ParallelUpdateThreshold = Settings->ParallelUpdateThreshold;
+	Settings->ParallelUpdateThreshold = 1;
+
+	// OnStart retargets the tween, its first frame has to use the new target
+	FBUITweenManager Manager;
+	UImage* Image = NewObject< UImage >( GetTransientPackage() );
+	FBUITweenHandle Handle = Manager.Create( Image, 1.0f ).Easing( EBUIEasingType::Linear ).ToOpacity( 1.0f );
+	Handle.OnStart( [&Handle]( UWidget* ) { Handle.ToOpacity( 0.0f ); } ).Begin();
+	Manager.Update( 0.5f );
+
+	TestEqual( TEXT( "First frame uses what OnStart set" ), Image->GetRenderOpacity(), 0.5f, 0.0001f );
+
+	Settings->ParallelUpdateThreshold = ParallelUpdateThreshold;
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenCurveEndTest, "BUITween.Manager.FinalFrameEasesToTheEnd",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenCurveEndTest::RunTest( const FString& Parameters )
+{
+	// A curve that only goes halfway, the last frame has to land there rather than on the target
+	UCurveFloat* Curve = NewObject< UCurveFloat >( GetTransientPackage() );
+	Curve->FloatCurve.AddKey( 0.0f, 0.0f );
+	Curve->FloatCurve.AddKey( 1.0f, 0.5f );
+
+	FBUITweenManager Manager;
+	UImage* Tweened = NewObject< UImage >( GetTransientPackage() );
+	UImage* Tracked = NewObject< UImage >( GetTransientPackage() );
+	Manager.Create( Tweened, 1.0f ).Easing( Curve ).ToOpacity( 0.0f ).Begin();
+	Manager.Sequence().Then( Tracked, 1.0f, [Curve]( FBUITweenInstance& T ) { T.Easing( Curve ).ToOpacity( 0.0f ); } ).Play();
+	Manager.Update( 1.5f );
+
+	TestEqual( TEXT( "Tween ends where its easing does" ), Tweened->GetRenderOpacity(), 0.5f, 0.01f );
+	TestEqual( TEXT( "Timeline track ends where its easing does" ), Tracked->GetRenderOpacity(), 0.5f, 0.01f );
+
+	// Same number of keys, different shape, so the cached table can't be reused
+	Curve->FloatCurve.Reset();
+	Curve->FloatCurve.AddKey( 0.0f, 0.0f );
+	Curve->FloatCurve.AddKey( 1.0f, 0.25f );
+	Tweened->SetRenderOpacity( 1.0f );
+	Manager.Create( Tweened, 1.0f ).Easing( Curve ).ToOpacity( 0.0f ).Begin();
+	Manager.Update( 1.5f );
+
+	TestEqual( TEXT( "Edited curve is baked again" ), Tweened->GetRenderOpacity(), 0.75f, 0.01f );
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenUpdateBudgetTest, "BUITween.Manager.UpdateBudgetAppliesOldestFirst",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenUpdateBudgetTest::RunTest( const FString& Parameters )
+{
+	UBUITweenSettings* Settings = GetMutableDefault<UBUITweenSettings>();
+	const float UpdateBudgetMs = Settings->UpdateBudgetMs;
+
+	// Too small for more than the one tween every update gets
+	Settings->UpdateBudgetMs = 0.000001f;
+
+	FBUITweenManager Manager;
+	UImage* Images[ 3 ];
+	for ( UImage*& Image : Images )
+	{
+		Image = NewObject< UImage >( GetTransientPackage() );
+		Manager.Create( Image, 1.0f ).Easing( EBUIEasingType::Linear ).ToOpacity( 0.0f ).UpdateRate( EBUITweenUpdateRate::Hz15 ).Begin();
+	}
+
+	// Every tween steps each update, but only one is applied, and never the same one twice in a row
+	Manager.Update( 0.1f );
+	TestEqual( TEXT( "Two tweens left over" ), Manager.GetNumOverBudget(), 2 );
+	TestEqual( TEXT( "First tween applied" ), Images[ 0 ]->GetRenderOpacity(), 0.9f, 0.0001f );
+	TestEqual( TEXT( "Third tween waits" ), Images[ 2 ]->GetRenderOpacity(), 1.0f );
+
+	Manager.Update( 0.1f );
+	TestEqual( TEXT( "Second tween catches up" ), Images[ 1 ]->GetRenderOpacity(), 0.8f, 0.0001f );
+	TestEqual( TEXT( "First tween waits its turn" ), Images[ 0 ]->GetRenderOpacity(), 0.9f, 0.0001f );
+
+	Manager.Update( 0.1f );
+	TestEqual( TEXT( "Third tween catches up on everything it missed" ), Images[ 2 ]->GetRenderOpacity(), 0.7f, 0.0001f );
+
+	Manager.Update( 0.1f );
+	TestEqual( TEXT( "Longest waiting goes next" ), Images[ 0 ]->GetRenderOpacity(), 0.6f, 0.0001f );
+
+	// The last frame is never held back
+	Manager.Update( 1.0f );
+	for ( UImage* Image : Images )
+	{
+		TestEqual( TEXT( "Every tween ends on its target" ), Image->GetRenderOpacity(), 0.0f );
+	}
+	TestEqual( TEXT( "Nothing left over" ), Manager.GetNumOverBudget(), 0 );
+
+	Settings->UpdateBudgetMs = UpdateBudgetMs;
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenCullingTest, "BUITween.Manager.CullingWhileHidden",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenCullingTest::RunTest( const FString& Parameters )
+{
+	// Each image sits in its own Slate box so it counts as part of a Slate tree, and culling only goes by
+	// its visibility
+	FBUITweenManager Manager;
+	UImage* Always = NewObject< UImage >( GetTransientPackage() );
+	UImage* CatchUp = NewObject< UImage >( GetTransientPackage() );
+	UImage* Completed = NewObject< UImage >( GetTransientPackage() );
+	UImage* Grouped = NewObject< UImage >( GetTransientPackage() );
+	TArray< TSharedRef< SBox > > Holders;
+	for ( UImage* Image : { Always, CatchUp, Completed, Grouped } )
+	{
+		Holders.Add( SNew( SBox )[ Image->TakeWidget() ] );
+	}
+
+	bool bCompleted = false;
+	Manager.SetGroupCulling( TEXT( "Culled" ), EBUITweenCulling::CatchUp );
+	Manager.Create( Always, 1.0f ).Easing( EBUIEasingType::Linear ).ToOpacity( 0.0f ).Culling( EBUITweenCulling::None ).Begin();
+	Manager.Create( CatchUp, 1.0f ).Easing( EBUIEasingType::Linear ).ToOpacity( 0.0f ).Culling( EBUITweenCulling::CatchUp ).Begin();
+	Manager.Create( Completed, 1.0f ).Easing( EBUIEasingType::Linear ).ToOpacity( 0.0f ).Culling( EBUITweenCulling::Complete )
+		.OnComplete( [&bCompleted]( UWidget* ) { bCompleted = true; } ).Begin();
+	Manager.Create( Grouped, 1.0f, 0.0f, false, TEXT( "Culled" ) ).Easing( EBUIEasingType::Linear ).ToOpacity( 0.0f ).Begin();
+	Manager.Update( 0.2f );
+	TestEqual( TEXT( "Shown tweens are applied" ), CatchUp->GetRenderOpacity(), 0.8f, 0.0001f );
+
+	// Collapsed and hidden both cull
+	Always->SetVisibility( ESlateVisibility::Collapsed );
+	CatchUp->SetVisibility( ESlateVisibility::Collapsed );
+	Completed->SetVisibility( ESlateVisibility::Hidden );
+	Grouped->SetVisibility( ESlateVisibility::Hidden );
+	Manager.Update( 0.2f );
+	TestEqual( TEXT( "Three tweens culled" ), Manager.GetNumCulled(), 3 );
+	TestEqual( TEXT( "Culling None still writes" ), Always->GetRenderOpacity(), 0.6f, 0.0001f );
+	TestEqual( TEXT( "CatchUp skips the write" ), CatchUp->GetRenderOpacity(), 0.8f, 0.0001f );
+	TestEqual( TEXT( "Complete skips the write" ), Completed->GetRenderOpacity(), 0.8f, 0.0001f );
+	TestEqual( TEXT( "Group policy applies" ), Grouped->GetRenderOpacity(), 0.8f, 0.0001f );
+	TestTrue( TEXT( "Culled tweens keep running" ), Manager.GetIsTweening( CatchUp ) && Manager.GetIsTweening( Completed ) );
+
+	Manager.Update( 0.2f );
+	for ( UImage* Image : { CatchUp, Completed, Grouped } )
+	{
+		Image->SetVisibility( ESlateVisibility::Visible );
+	}
+	Manager.Update( 0.1f );
+	TestEqual( TEXT( "CatchUp applies the time it missed on reveal" ), CatchUp->GetRenderOpacity(), 0.3f, 0.0001f );
+	TestEqual( TEXT( "Group CatchUp applies the time it missed on reveal" ), Grouped->GetRenderOpacity(), 0.3f, 0.0001f );
+	TestEqual( TEXT( "Complete jumps to the end on reveal" ), Completed->GetRenderOpacity(), 0.0f );
+	TestTrue( TEXT( "Complete fires OnComplete on reveal" ), bCompleted );
+	TestFalse( TEXT( "Completed tween is gone" ), Manager.GetIsTweening( Completed ) );
+	TestTrue( TEXT( "CatchUp tween keeps running" ), Manager.GetIsTweening( CatchUp ) );
+
+	// The last frame is applied even while hidden
+	CatchUp->SetVisibility( ESlateVisibility::Collapsed );
+	Manager.Update( 1.0f );
+	TestEqual( TEXT( "Hidden tween still ends on its target" ), CatchUp->GetRenderOpacity(), 0.0f );
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenStaleHandleTest, "BUITween.Manager.StaleHandles",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenStaleHandleTest::RunTest( const FString& Parameters )
+{
+	// Released slots come back with the generation bumped past the old handle's
+	FBUITweenPool Pool;
+	const FBUITweenHandle First = Pool.Add( nullptr );
+	TestTrue( TEXT( "Live slot has an odd generation" ), ( First.GetGeneration() & 1 ) == 1 );
+	TestTrue( TEXT( "Remove succeeds once" ), Pool.Remove( First ) );
+	TestFalse( TEXT( "Remove fails on a stale handle" ), Pool.Remove( First ) );
+	TestNull( TEXT( "Removed handle resolves to nothing" ), Pool.Get( First ) );
+	Pool.ReleasePendingSlots();
+
+	const FBUITweenHandle Second = Pool.Add( nullptr );
+	TestEqual( TEXT( "Released slot is reused" ), Second.GetIndex(), First.GetIndex() );
+	TestEqual( TEXT( "Reused slot's generation moves on" ), Second.GetGeneration(), First.GetGeneration() + 2 );
+	TestNull( TEXT( "Old handle doesn't resolve to the new tween" ), Pool.Get( First ) );
+	TestNotNull( TEXT( "New handle resolves" ), Pool.Get( Second ) );
+
+	Pool.Empty();
+	TestNull( TEXT( "Empty makes live handles stale" ), Pool.Get( Second ) );
+	const FBUITweenHandle Third = Pool.Add( nullptr );
+	TestNull( TEXT( "Handle from before Empty doesn't match the slot's next tween" ), Pool.Get( Second ) );
+	TestTrue( TEXT( "Slot after Empty is a new generation" ), Third.GetIndex() != Second.GetIndex() || Third.GetGeneration() > Second.GetGeneration() );
+
+	// Through the manager, completing and emptying both leave handles inert
+	FBUITweenManager Manager;
+	UImage* Image = NewObject< UImage >( GetTransientPackage() );
+	FBUITweenHandle Completed = Manager.Create( Image, 0.1f ).ToOpacity( 0.5f ).Begin();
+	Manager.Update( 0.2f );
+	TestFalse( TEXT( "Completed handle is stale" ), Completed.IsValid() );
+	TestFalse( TEXT( "Cancel through a completed handle fails" ), Completed.Cancel() );
+
+	FBUITweenHandle Emptied = Manager.Create( Image, 1.0f ).ToOpacity( 0.0f ).Begin();
+	Manager.Empty();
+	TestFalse( TEXT( "Handle from before Empty is stale" ), Emptied.IsValid() );
+	Emptied.Pause().Resume().Begin();
+	TestEqual( TEXT( "Calls through a stale handle do nothing" ), Manager.Num(), 0 );
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenWidgetIndexTest, "BUITween.Manager.WidgetIndex",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenWidgetIndexTest::RunTest( const FString& Parameters )
+{
+	FBUITweenManager Manager;
+	UImage* Layered = NewObject< UImage >( GetTransientPackage() );
+	UImage* Other = NewObject< UImage >( GetTransientPackage() );
+	UImage* Untouched = NewObject< UImage >( GetTransientPackage() );
+
+	Manager.Create( Layered, 1.0f, 0.0f, true ).ToOpacity( 0.5f ).Begin();
+	Manager.Create( Layered, 1.0f, 0.5f, true ).ToTranslation( 10, 0 ).Begin();
+	Manager.Create( Layered, 1.0f, 0.0f, true ).ToScale( FVector2D( 2, 2 ) );
+	FBUITweenHandle OtherTween = Manager.Create( Other, 0.5f ).ToOpacity( 0.5f ).Begin();
+
+	// Running, delayed and not yet begun tweens are all indexed
+	TArray< FBUITweenHandle > Handles;
+	Manager.GetTweens( Layered, Handles );
+	TestEqual( TEXT( "Every tween on the widget is listed" ), Handles.Num(), 3 );
+	TestTrue( TEXT( "Widget with tweens is tweening" ), Manager.GetIsTweening( Layered ) );
+	TestFalse( TEXT( "Widget without tweens isn't" ), Manager.GetIsTweening( Untouched ) );
+	TestEqual( TEXT( "Clearing an untouched widget removes nothing" ), Manager.Clear( Untouched ), 0 );
+
+	TestEqual( TEXT( "Clear removes every tween on the widget" ), Manager.Clear( Layered ), 3 );
+	TestFalse( TEXT( "Cleared widget isn't tweening" ), Manager.GetIsTweening( Layered ) );
+	for ( const FBUITweenHandle& Handle : Handles )
+	{
+		TestFalse( TEXT( "Cleared tween's handle is stale" ), Handle.IsValid() );
+	}
+	TestTrue( TEXT( "Clear leaves other widgets alone" ), Manager.GetIsTweening( Other ) && OtherTween.IsValid() );
+
+	// A non-additive tween takes the widget over, and the index follows completion
+	FBUITweenHandle Replacement = Manager.Create( Other, 0.5f ).ToOpacity( 0.25f ).Begin();
+	TestFalse( TEXT( "Non-additive Create clears the widget's tweens" ), OtherTween.IsValid() );
+	Handles.Reset();
+	Manager.GetTweens( Other, Handles );
+	TestTrue( TEXT( "Only the new tween is indexed" ), Handles.Num() == 1 && Handles[ 0 ] == Replacement );
+	Manager.Update( 1.0f );
+	TestFalse( TEXT( "Completed widget isn't tweening" ), Manager.GetIsTweening( Other ) );
+	TestEqual( TEXT( "Clear after completion removes nothing" ), Manager.Clear( Other ), 0 );
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenSkippedWritesTest, "BUITween.Manager.SkipsUnchangedSetters",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenSkippedWritesTest::RunTest( const FString& Parameters )
+{
+	FBUITweenManager Manager;
+	UImage* Still = NewObject< UImage >( GetTransientPackage() );
+	UImage* Moving = NewObject< UImage >( GetTransientPackage() );
+
+	// Tweening to the value the widget already has never needs the setter
+	Manager.Create( Still, 1.0f ).ToOpacity( 1.0f ).Begin();
+	Manager.Update( 0.1f );
+	TestEqual( TEXT( "Unchanged opacity is skipped" ), Manager.GetWriteCounters().Skipped, 1 );
+	TestEqual( TEXT( "Nothing issued for an unchanged value" ), Manager.GetWriteCounters().Issued, 0 );
+
+	Manager.Create( Moving, 1.0f ).Easing( EBUIEasingType::Linear ).ToOpacity( 0.0f ).Begin();
+	Manager.Update( 0.1f );
+	TestEqual( TEXT( "Changed opacity is written" ), Manager.GetWriteCounters().Issued, 1 );
+	TestEqual( TEXT( "Unchanged one is still skipped" ), Manager.GetWriteCounters().Skipped, 1 );
+	TestEqual( TEXT( "Written value lands" ), Moving->GetRenderOpacity(), 0.9f, 0.0001f );
+
+	// The counters cover the most recent update only
+	Manager.Clear( Moving );
+	Manager.Update( 0.1f );
+	TestEqual( TEXT( "Counters reset each update" ), Manager.GetWriteCounters().Issued, 0 );
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenGroupsTest, "BUITween.Manager.GroupTimeScalePauseCancel",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenGroupsTest::RunTest( const FString& Parameters )
+{
+	FBUITweenManager Manager;
+	UImage* Default = NewObject< UImage >( GetTransientPackage() );
+	UImage* Fast = NewObject< UImage >( GetTransientPackage() );
+	UImage* Paused = NewObject< UImage >( GetTransientPackage() );
+	UImage* Cancelled = NewObject< UImage >( GetTransientPackage() );
+
+	bool bCancelledCompleted = false;
+	Manager.SetGroupTimeScale( TEXT( "Fast" ), 2.0f );
+	Manager.SetGroupPaused( TEXT( "Paused" ), true );
+	Manager.Create( Default, 1.0f ).Easing( EBUIEasingType::Linear ).ToOpacity( 0.0f ).Begin();
+	Manager.Create( Fast, 1.0f, 0.0f, false, TEXT( "Fast" ) ).Easing( EBUIEasingType::Linear ).ToOpacity( 0.0f ).Begin();
+	Manager.Create( Paused, 1.0f, 0.0f, false, TEXT( "Paused" ) ).Easing( EBUIEasingType::Linear ).ToOpacity( 0.0f ).Begin();
+	Manager.Create( Cancelled, 1.0f, 0.0f, false, TEXT( "Cancelled" ) ).ToOpacity( 0.0f )
+		.OnComplete( [&bCancelledCompleted]( UWidget* ) { bCancelledCompleted = true; } ).Begin();
+	Manager.Create( Cancelled, 1.0f, 0.5f, true, TEXT( "Cancelled" ) ).ToTranslation( 10, 0 ).Begin();
+
+	Manager.Update( 0.25f );
+	TestEqual( TEXT( "Default group runs at normal speed" ), Default->GetRenderOpacity(), 0.75f, 0.0001f );
+	TestEqual( TEXT( "Time scale speeds the group up" ), Fast->GetRenderOpacity(), 0.5f, 0.0001f );
+	TestEqual( TEXT( "Paused group doesn't move" ), Paused->GetRenderOpacity(), 1.0f );
+	TestEqual( TEXT( "Time scale is kept" ), Manager.GetGroupTimeScale( TEXT( "Fast" ) ), 2.0f );
+
+	// Cancelling a group only removes its own tweens, delayed ones included, without OnComplete
+	TestEqual( TEXT( "Group counts its tweens" ), Manager.GetGroupNum( TEXT( "Cancelled" ) ), 2 );
+	TestEqual( TEXT( "CancelGroup removes every tween in it" ), Manager.CancelGroup( TEXT( "Cancelled" ) ), 2 );
+	TestEqual( TEXT( "Cancelled group is empty" ), Manager.GetGroupNum( TEXT( "Cancelled" ) ), 0 );
+	TestFalse( TEXT( "Cancelled widget isn't tweening" ), Manager.GetIsTweening( Cancelled ) );
+	TestTrue( TEXT( "Other groups keep their tweens" ), Manager.GetIsTweening( Default ) && Manager.GetIsTweening( Paused ) );
+
+	// Resuming carries on from where the group was paused
+	Manager.SetGroupPaused( TEXT( "Paused" ), false );
+	Manager.Update( 0.25f );
+	TestEqual( TEXT( "Resumed group carries on" ), Paused->GetRenderOpacity(), 0.75f, 0.0001f );
+	TestFalse( TEXT( "Fast group finished first" ), Manager.GetIsTweening( Fast ) );
+	TestTrue( TEXT( "Default group still running" ), Manager.GetIsTweening( Default ) );
+
+	Manager.Update( 1.0f );
+	TestFalse( TEXT( "Cancelled tween never completes" ), bCancelledCompleted );
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenStaggeredTest, "BUITween.Manager.StaggeredPerChildDelay",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenStaggeredTest::RunTest( const FString& Parameters )
+{
+	FBUITweenManager Manager;
+	TArray< UWidget* > Widgets;
+	for ( int32 Index = 0; Index < 3; ++Index )
+	{
+		Widgets.Add( NewObject< UImage >( GetTransientPackage() ) );
+	}
+
+	int32 NumStarted = 0;
+	int32 NumCompleted = 0;
+	Manager.CreateStaggered( Widgets, 1.0f, 0.5f ).Easing( EBUIEasingType::Linear ).ToOpacity( 0.0f )
+		.OnStart( [&NumStarted]( UWidget* ) { NumStarted++; } )
+		.OnComplete( [&NumCompleted]( UWidget* ) { NumCompleted++; } ).Begin();
+
+	// Each child starts half a second after the one before
+	Manager.Update( 0.75f );
+	TestEqual( TEXT( "First child is 0.75s in" ), Widgets[ 0 ]->GetRenderOpacity(), 0.25f, 0.0001f );
+	TestEqual( TEXT( "Second child is 0.25s in" ), Widgets[ 1 ]->GetRenderOpacity(), 0.75f, 0.0001f );
+	TestEqual( TEXT( "Third child hasn't started" ), Widgets[ 2 ]->GetRenderOpacity(), 1.0f );
+	TestEqual( TEXT( "OnStart fires once for the list" ), NumStarted, 1 );
+
+	Manager.Update( 1.0f );
+	TestEqual( TEXT( "First child finished" ), Widgets[ 0 ]->GetRenderOpacity(), 0.0f );
+	TestEqual( TEXT( "Second child finished" ), Widgets[ 1 ]->GetRenderOpacity(), 0.0f );
+	TestEqual( TEXT( "Third child is 0.75s in" ), Widgets[ 2 ]->GetRenderOpacity(), 0.25f, 0.0001f );
+	TestEqual( TEXT( "OnComplete waits for the last child" ), NumCompleted, 0 );
+
+	Manager.Update( 0.25f );
+	TestEqual( TEXT( "Last child finished" ), Widgets[ 2 ]->GetRenderOpacity(), 0.0f );
+	TestEqual( TEXT( "OnComplete fires once for the list" ), NumCompleted, 1 );
+	TestFalse( TEXT( "Nothing left tweening" ), Manager.GetIsTweening( Widgets[ 2 ] ) );
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenDelayRemainderTest, "BUITween.Manager.DelayRemainderCarriesOver",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenDelayRemainderTest::RunTest( const FString& Parameters )
+{
+	FBUITweenManager Manager;
+	UImage* Delayed = NewObject< UImage >( GetTransientPackage() );
+	UImage* Scaled = NewObject< UImage >( GetTransientPackage() );
+
+	// The delay runs out a quarter second into the update, so the first frame is a quarter second in
+	Manager.Create( Delayed, 1.0f, 0.25f ).Easing( EBUIEasingType::Linear ).ToOpacity( 0.0f ).Begin();
+	Manager.SetGroupTimeScale( TEXT( "Scaled" ), 0.5f );
+	Manager.Create( Scaled, 1.0f, 0.1f, false, TEXT( "Scaled" ) ).Easing( EBUIEasingType::Linear ).ToOpacity( 0.0f ).Begin();
+	Manager.Update( 0.5f );
+
+	TestEqual( TEXT( "First frame only has the time past the delay" ), Delayed->GetRenderOpacity(), 0.75f, 0.0001f );
+	TestEqual( TEXT( "Remainder is in the group's time" ), Scaled->GetRenderOpacity(), 0.85f, 0.0001f );
+
+	// From then on the tween is exactly as far along as the time since its delay ran out
+	Manager.Update( 0.5f );
+	TestEqual( TEXT( "Later frames keep the offset" ), Delayed->GetRenderOpacity(), 0.25f, 0.0001f );
+	Manager.Update( 0.25f );
+	TestFalse( TEXT( "Ends delay plus duration after Begin" ), Manager.GetIsTweening( Delayed ) );
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenPreparedTest, "BUITween.Manager.PreparedTweensWait",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenPreparedTest::RunTest( const FString& Parameters )
+{
+	FBUITweenManager Manager;
+	UImage* Image = NewObject< UImage >( GetTransientPackage() );
+
+	bool bStarted = false;
+	FBUITweenHandle Prepared = Manager.Create( Image, 1.0f ).Easing( EBUIEasingType::Linear ).ToOpacity( 0.0f )
+		.OnStart( [&bStarted]( UWidget* ) { bStarted = true; } );
+
+	// Updates leave a tween that hasn't begun alone, however much time passes
+	for ( int32 Update = 0; Update < 4; ++Update )
+	{
+		Manager.Update( 1.0f );
+	}
+	TestTrue( TEXT( "Prepared tween is still alive" ), Prepared.IsValid() );
+	TestFalse( TEXT( "Prepared tween hasn't started" ), bStarted );
+	TestEqual( TEXT( "Prepared tween hasn't written" ), Image->GetRenderOpacity(), 1.0f );
+	TestEqual( TEXT( "Prepared tween counts in its group" ), Manager.GetGroupNum( NAME_None ), 1 );
+	TestEqual( TEXT( "Nothing was written" ), Manager.GetWriteCounters().Issued + Manager.GetWriteCounters().Skipped, 0 );
+
+	// Its clock starts at Begin, not at Create
+	Prepared.Begin();
+	Manager.Update( 0.25f );
+	TestTrue( TEXT( "Begun tween starts" ), bStarted );
+	TestEqual( TEXT( "Time counts from Begin" ), Image->GetRenderOpacity(), 0.75f, 0.0001f );
+	return true;
+}
+
+#endif
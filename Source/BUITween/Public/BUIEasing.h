@@ -4,7 +4,7 @@
 #include "CoreUObject.h"
 
 UENUM()
-enum class EBUIEasingType
+enum class EBUIEasingType : uint8
 {
 	Linear,
 	Smoothstep,
@@ -37,11 +37,36 @@ enum class EBUIEasingType
 	InOutBack,
 };
 
-struct FBUIEasing
+// An easing curve over normalised time t in [0, 1]. Elastic curves take their period relative to the
+// tween's duration, so pass period / duration.
+typedef float ( *FBUIEasingFunction )( float t, float overshootOrAmplitude, float period );
+
+// A baked curve, see FBUIEasingTableCache. Tweens hold on to the tables they use, so the cache can drop them
+// at any time.
+struct FBUIEasingTable;
+typedef TSharedPtr< const FBUIEasingTable > FBUIEasingTablePtr;
+
+struct BUITWEEN_API FBUIEasing
 {
 public:
 	#define TWO_PI          (6.28318530717f)
 
+	// Picks the curve once so per-frame callers make a single indirect call instead of going through Ease()
+	static FBUIEasingFunction Resolve( EBUIEasingType Type );
+
+	static constexpr int32 NumEasingTypes = (int32)EBUIEasingType::InOutBack + 1;
+
+	// Evaluates Count tweens that share one easing type, 4 lanes at a time with VectorRegister math.
+	// Linear, Smoothstep, the polynomial, Sine and Back curves have vector paths; Expo, Circ and Elastic,
+	// and the tail that doesn't fill a register, use the Resolve()d scalar function.
+	// Vector results match Ease() to within EaseBatchTolerance over time in [0, duration].
+	static constexpr float EaseBatchTolerance = 1.e-5f;
+	static void EaseBatch( EBUIEasingType Type, const float* Time, const float* Duration, float* Out, int32 Count, float overshootOrAmplitude = 0.1f, float period = 1.0f );
+
+	// CSS cubic-bezier( X1, Y1, X2, Y2 ) at normalised time t. Solves for the curve parameter on every call,
+	// tweens use the table from FBUIEasingTableCache::GetForBezier instead.
+	static float CubicBezier( float t, float X1, float Y1, float X2, float Y2 );
+
 	static float Ease( EBUIEasingType Type, float time, float duration = 1.0f, float overshootOrAmplitude = 0.1f, float period = 1.0f )
 	{
 		switch ( Type )
@@ -307,4 +332,14 @@ public:
 
 };
 
+// Compile-time easing, Ease() folds down to the one case when it is inlined with a constant type
+template<EBUIEasingType Type>
+struct TBUIEasing
+{
+	static FORCEINLINE float Eval( float t, float overshootOrAmplitude = 0.1f, float period = 1.0f )
+	{
+		return FBUIEasing::Ease( Type, t, 1.0f, overshootOrAmplitude, period );
+	}
+};
+
 #undef TWO_PI
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BUIEasing.h"
+#include "BUITweenSettings.h"
+#include "UObject/ObjectKey.h"
+
+class UCurveFloat;
+
+// An easing curve sampled uniformly over normalised time [0, 1]
+struct BUITWEEN_API FBUIEasingTable
+{
+public:
+	// Samples Fn at the starting resolution, doubling it until the table is within InMaxError of Fn or
+	// InMaxResolution is reached. Returns the measured worst-case error.
+	float Bake( TFunctionRef<float( float )> Fn, EBUIEasingTableInterpolation InInterpolation, int32 InResolution, int32 InMaxResolution, float InMaxError );
+
+	// Largest difference from Fn over NumProbesPerInterval evenly spaced probes inside every interval,
+	// which is where interpolation error peaks
+	float MeasureMaxError( TFunctionRef<float( float )> Fn, int32 NumProbesPerInterval = 8 ) const;
+
+	float Sample( float t ) const
+	{
+		const float X = FMath::Clamp( t, 0.0f, 1.0f ) * Resolution;
+		const int32 Index = FMath::Min( (int32)X, Resolution - 1 );
+		const float Frac = X - Index;
+		const float V0 = Values[ Index ];
+		const float V1 = Values[ Index + 1 ];
+
+		if ( Interpolation == EBUIEasingTableInterpolation::Linear )
+		{
+			return V0 + ( V1 - V0 ) * Frac;
+		}
+
+		// Cubic Hermite, slopes are stored per unit t so scale them to the interval width
+		const float Frac2 = Frac * Frac;
+		const float Frac3 = Frac2 * Frac;
+		const float H00 = 2 * Frac3 - 3 * Frac2 + 1;
+		const float H10 = Frac3 - 2 * Frac2 + Frac;
+		const float H01 = -2 * Frac3 + 3 * Frac2;
+		const float H11 = Frac3 - Frac2;
+		return H00 * V0 + H10 * Slopes[ Index ] * InvResolution + H01 * V1 + H11 * Slopes[ Index + 1 ] * InvResolution;
+	}
+
+	int32 GetResolution() const { return Resolution; }
+	float GetMaxError() const { return MaxError; }
+
+private:
+	void Resample( TFunctionRef<float( float )> Fn );
+
+	// Resolution + 1 samples, the last one is t = 1
+	TArray< float > Values;
+	// dValue/dt at each sample, only filled for Hermite
+	TArray< float > Slopes;
+	EBUIEasingTableInterpolation Interpolation = EBUIEasingTableInterpolation::Linear;
+	int32 Resolution = 0;
+	float InvResolution = 0;
+	float MaxError = 0;
+};
+
+// Baked tables for the built-in curves, one per (type, overshootOrAmplitude, period), and for custom curves,
+// one per distinct shape. Tables are baked on first use with the resolution settings from UBUITweenSettings.
+// Tweens keep a reference to the tables they use, so Empty() and Trim() never pull one out from under them.
+class BUITWEEN_API FBUIEasingTableCache
+{
+public:
+	static FBUIEasingTablePtr Get( EBUIEasingType Type, float overshootOrAmplitude = 0.1f, float period = 1.0f );
+
+	// Table matching FBUIEasing::Ease( Type, time, Duration, overshootOrAmplitude ). Elastic curves are
+	// shaped by their period relative to the duration, so they get one table per distinct duration.
+	static FBUIEasingTablePtr GetForTween( EBUIEasingType Type, float Duration, float overshootOrAmplitude = 0.1f );
+
+	// Table for a designer-authored curve, with its first to last key mapped onto [0, 1]. Looked up by curve
+	// object, so repeat calls don't allocate. Curve assets with the same keys share one table, and in
+	// editor builds a curve that was edited bakes a new one the next time it is used.
+	static FBUIEasingTablePtr GetForCurve( const UCurveFloat& Curve );
+
+	// Table for FBUIEasing::CubicBezier( t, X1, Y1, X2, Y2 )
+	static FBUIEasingTablePtr GetForBezier( float X1, float Y1, float X2, float Y2 );
+
+	// Drops every table no tween is using. Runs by itself whenever the number of cached tables doubles, so
+	// tweens with data-driven durations or easing params don't keep a table each forever.
+	static void Trim();
+
+	static void Empty();
+
+	static int32 Num() { return Tables.Num() + CustomTables.Num(); }
+
+private:
+	static FBUIEasingTablePtr Bake( TFunctionRef<float( float )> Fn, const FString& Name );
+	// Trims once enough tables have been added since the last time
+	static void TrimIfGrown();
+
+	// What a custom curve's shape depends on, compared whole so different curves never share a table.
+	// Inline for beziers, so looking one up doesn't allocate.
+	struct FCustomKey
+	{
+		TArray< float, TInlineAllocator<8> > Shape;
+
+		bool operator==( const FCustomKey& Other ) const
+		{
+			return Shape == Other.Shape;
+		}
+		friend uint32 GetTypeHash( const FCustomKey& Key )
+		{
+			return FCrc::MemCrc32( Key.Shape.GetData(), Key.Shape.Num() * sizeof( float ) );
+		}
+	};
+	// GetName is only called when the table has to be baked
+	static FBUIEasingTablePtr GetCustom( FCustomKey&& Key, TFunctionRef<float( float )> Fn, TFunctionRef<FString()> GetName );
+
+	// Table a curve object resolved to last time, and its keys' stamp at that point. Weak, so the entry
+	// doesn't keep a trimmed table alive.
+	struct FCurveEntry
+	{
+		TWeakPtr< const FBUIEasingTable > Table;
+		uint32 Stamp;
+	};
+	static uint32 GetCurveStamp( const UCurveFloat& Curve );
+
+	struct FKey
+	{
+		EBUIEasingType Type;
+		float OvershootOrAmplitude;
+		float Period;
+
+		bool operator==( const FKey& Other ) const
+		{
+			return Type == Other.Type && OvershootOrAmplitude == Other.OvershootOrAmplitude && Period == Other.Period;
+		}
+		friend uint32 GetTypeHash( const FKey& Key )
+		{
+			return HashCombine( HashCombine( ::GetTypeHash( (uint8)Key.Type ), ::GetTypeHash( Key.OvershootOrAmplitude ) ), ::GetTypeHash( Key.Period ) );
+		}
+	};
+
+	static TMap< FKey, FBUIEasingTablePtr > Tables;
+	static TMap< FCustomKey, FBUIEasingTablePtr > CustomTables;
+	static TMap< FObjectKey, FCurveEntry > CurveTables;
+	// Num() at which TrimIfGrown trims next
+	static int32 NextTrimAt;
+};
@@ -3,8 +3,12 @@
 #include "BUIEasing.h"
 #include "Components/Widget.h"
 #include "BUITweenInstance.h"
+#include "BUITweenHandle.h"
+#include "BUITweenManager.h"
 #include "BUITween.generated.h"
 
+// Static front end for the default FBUITweenManager, which the module ticks once per engine frame.
+// Functions taking a handle go to whichever manager created it.
 UCLASS()
 class BUITWEEN_API UBUITween : public UObject
 {
@@ -14,23 +18,80 @@ public:
 	static void Startup();
 	static void Shutdown();
 
-	// Create a new tween on the target widget, does not start automatically
-	static FBUITweenInstance& Create( UWidget* pInWidget, float InDuration = 1.0f, float InDelay = 0.0f, bool bIsAdditive = false );
+	static FBUITweenManager& GetDefaultManager();
+
+	// Create a new tween on the target widget, does not start automatically.
+	// Non-additive tweens clear any existing tweens on the widget first. Additive tweens are layered on top of
+	// whatever else is tweening the widget, see FBUITweenInstance::bIsAdditive.
+	static FBUITweenHandle Create( UWidget* pInWidget, float InDuration = 1.0f, float InDelay = 0.0f, bool bIsAdditive = false, FName InGroup = NAME_None )
+	{
+		return GetDefaultManager().Create( pInWidget, InDuration, InDelay, bIsAdditive, InGroup );
+	}
+
+	// One tween over a list of widgets, see FBUITweenManager::CreateStaggered
+	static FBUITweenHandle CreateStaggered( TArrayView< UWidget* > Widgets, float InDuration, float InPerItemDelay, float InDelay = 0.0f, bool bIsAdditive = false, FName InGroup = NAME_None )
+	{
+		return GetDefaultManager().CreateStaggered( Widgets, InDuration, InPerItemDelay, InDelay, bIsAdditive, InGroup );
+	}
 
 	// Cancel all tweens on the target widget, returns the number of tween instances removed
-	static int32 Clear( UWidget* pInWidget );
+	static int32 Clear( UWidget* pInWidget ) { return GetDefaultManager().Clear( pInWidget ); }
 
-	static void Update( float InDeltaTime );
+	// Snapshots the widget's current state and starts the tween's clock
+	static void Begin( FBUITweenHandle Handle ) { Handle.Begin(); }
 
-	static bool GetIsTweening( UWidget* pInWidget );
+	// Cancel a single tween without firing its OnComplete, returns false if the handle was stale
+	static bool Cancel( FBUITweenHandle Handle ) { return Handle.Cancel(); }
 
-	static void CompleteAll();
+	static void SetPaused( FBUITweenHandle Handle, bool bInPaused )
+	{
+		if ( bInPaused ) Handle.Pause(); else Handle.Resume();
+	}
+	static bool IsPaused( FBUITweenHandle Handle ) { return Handle.IsPaused(); }
 
-protected:
-	static bool bIsInitialized;
+	// Returns nullptr once the tween has completed or been cancelled
+	static FBUITweenInstance* GetInstance( FBUITweenHandle Handle ) { return Handle.Resolve(); }
+
+	// See FBUITweenManager::Update for the callback ordering
+	static void Update( float InDeltaTime ) { GetDefaultManager().Update( InDeltaTime ); }
+
+	// Groups, see FBUITweenManager::SetGroupPaused
+	static void SetGroupTimeScale( FName InGroup, float InTimeScale ) { GetDefaultManager().SetGroupTimeScale( InGroup, InTimeScale ); }
+	static float GetGroupTimeScale( FName InGroup ) { return GetDefaultManager().GetGroupTimeScale( InGroup ); }
+	static void SetGroupPaused( FName InGroup, bool bInPaused ) { GetDefaultManager().SetGroupPaused( InGroup, bInPaused ); }
+	static bool IsGroupPaused( FName InGroup ) { return GetDefaultManager().IsGroupPaused( InGroup ); }
+	static void SetGroupCulling( FName InGroup, EBUITweenCulling InCulling ) { GetDefaultManager().SetGroupCulling( InGroup, InCulling ); }
+	static int32 CancelGroup( FName InGroup ) { return GetDefaultManager().CancelGroup( InGroup ); }
+	static void CompleteGroup( FName InGroup ) { GetDefaultManager().CompleteGroup( InGroup ); }
+
+	// Starts building a timeline on the default manager, see FBUITweenTimeline
+	static FBUITweenTimeline Sequence() { return GetDefaultManager().Sequence(); }
+
+	static bool GetIsTweening( UWidget* pInWidget ) { return GetDefaultManager().GetIsTweening( pInWidget ); }
 
-	static TArray< FBUITweenInstance > ActiveInstances;
+	// Appends the handles of every tween on the target widget, including ones that have not started yet
+	static void GetTweens( UWidget* pInWidget, TArray< FBUITweenHandle >& OutHandles )
+	{
+		GetDefaultManager().GetTweens( pInWidget, OutHandles );
+	}
 
-	// We delay adding until the end of an update so we don't add to ActiveInstances within our update loop
-	static TArray< FBUITweenInstance > InstancesToAdd;
+	// Appends every timeline with a track playing on the target widget
+	static void GetTimelines( UWidget* pInWidget, TArray< FBUITweenTimelineHandle >& OutHandles )
+	{
+		GetDefaultManager().GetTimelines( pInWidget, OutHandles );
+	}
+
+	static void CompleteAll() { GetDefaultManager().CompleteAll(); }
+
+	// Setter calls issued and skipped by the most recent Update, plus any Begin calls made since
+	static const FBUITweenWriteCounters& GetWriteCounters() { return GetDefaultManager().GetWriteCounters(); }
+
+	// Allocations made from the end of the previous Update to the end of the most recent one
+	static const FBUITweenAllocationCounters& GetAllocationCounters() { return GetDefaultManager().GetAllocationCounters(); }
+
+	// Bytes held by the default manager
+	static SIZE_T GetAllocatedSize() { return GetDefaultManager().GetAllocatedSize(); }
+
+protected:
+	static TUniquePtr< FBUITweenManager > DefaultManager;
 };
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/TypeCompatibleBytes.h"
+#include "Components/Widget.h"
+
+DECLARE_DELEGATE_OneParam( FBUITweenSignature, UWidget* /*Owner*/ );
+
+// Storage for OnStart/OnComplete. Functors taking a UWidget* that fit in InlineSize bytes (a lambda capturing
+// a few pointers) are kept inside the tween instance, so setting them doesn't allocate. Bigger functors and
+// delegates go through FBUITweenSignature, which does.
+class BUITWEEN_API FBUITweenCallback
+{
+public:
+	enum { InlineSize = 32, InlineAlignment = 16 };
+
+	FBUITweenCallback() { }
+	~FBUITweenCallback() { Reset(); }
+
+	FBUITweenCallback( FBUITweenCallback&& Other )
+	{
+		MoveFrom( Other );
+	}
+	FBUITweenCallback& operator=( FBUITweenCallback&& Other )
+	{
+		if ( this != &Other )
+		{
+			Reset();
+			MoveFrom( Other );
+		}
+		return *this;
+	}
+	FBUITweenCallback( const FBUITweenCallback& ) = delete;
+	FBUITweenCallback& operator=( const FBUITweenCallback& ) = delete;
+
+	void Set( const FBUITweenSignature& InDelegate )
+	{
+		Reset();
+		Delegate = InDelegate;
+		if ( Delegate.IsBound() )
+		{
+			NumHeapBindings++;
+		}
+	}
+	// Moving doesn't allocate, but the delegate's binding lives on the heap all the same
+	void Set( FBUITweenSignature&& InDelegate )
+	{
+		Reset();
+		Delegate = MoveTemp( InDelegate );
+		if ( Delegate.IsBound() )
+		{
+			NumHeapBindings++;
+		}
+	}
+	template<typename FunctorType, typename TEnableIf<!TIsSame<typename TDecay<FunctorType>::Type, FBUITweenSignature>::Value, int>::Type = 0>
+	void Set( FunctorType&& Functor )
+	{
+		typedef typename TDecay<FunctorType>::Type FFunctor;
+		Reset();
+		SetFunctor( Forward<FunctorType>( Functor ), TIntegralConstant<bool, sizeof( FFunctor ) <= InlineSize && alignof( FFunctor ) <= InlineAlignment>() );
+	}
+
+	void ExecuteIfBound( UWidget* Owner )
+	{
+		if ( Ops )
+		{
+			Ops->Call( GetStorage(), Owner );
+		}
+		else
+		{
+			Delegate.ExecuteIfBound( Owner );
+		}
+	}
+
+	bool IsBound() const { return Ops != nullptr || Delegate.IsBound(); }
+
+	void Reset()
+	{
+		if ( Ops )
+		{
+			Ops->Destroy( GetStorage() );
+			Ops = nullptr;
+		}
+		Delegate.Unbind();
+	}
+
+	// Running total of callbacks that had to be stored on the heap
+	static int32 GetNumHeapBindings() { return NumHeapBindings; }
+
+private:
+	struct FOps
+	{
+		void ( *Call )( void* Storage, UWidget* Owner );
+		void ( *MoveConstruct )( void* Dest, void* Src );
+		void ( *Destroy )( void* Storage );
+	};
+
+	template<typename FFunctor>
+	struct TOps
+	{
+		static void Call( void* Storage, UWidget* Owner ) { ( *(FFunctor*)Storage )( Owner ); }
+		static void MoveConstruct( void* Dest, void* Src ) { new ( Dest ) FFunctor( MoveTemp( *(FFunctor*)Src ) ); }
+		static void Destroy( void* Storage ) { ( (FFunctor*)Storage )->~FFunctor(); }
+
+		static const FOps* Get()
+		{
+			static const FOps Ops = { &Call, &MoveConstruct, &Destroy };
+			return &Ops;
+		}
+	};
+
+	template<typename FunctorType>
+	void SetFunctor( FunctorType&& Functor, TIntegralConstant<bool, true> )
+	{
+		typedef typename TDecay<FunctorType>::Type FFunctor;
+		new ( GetStorage() ) FFunctor( Forward<FunctorType>( Functor ) );
+		Ops = TOps<FFunctor>::Get();
+	}
+	template<typename FunctorType>
+	void SetFunctor( FunctorType&& Functor, TIntegralConstant<bool, false> )
+	{
+		Delegate.BindLambda( Forward<FunctorType>( Functor ) );
+		NumHeapBindings++;
+	}
+
+	void MoveFrom( FBUITweenCallback& Other )
+	{
+		if ( Other.Ops )
+		{
+			Other.Ops->MoveConstruct( GetStorage(), Other.GetStorage() );
+			Other.Ops->Destroy( Other.GetStorage() );
+			Ops = Other.Ops;
+			Other.Ops = nullptr;
+		}
+		Delegate = MoveTemp( Other.Delegate );
+	}
+
+	void* GetStorage() { return &Storage; }
+
+	TAlignedBytes< InlineSize, InlineAlignment > Storage;
+	const FOps* Ops = nullptr;
+	FBUITweenSignature Delegate;
+
+	static int32 NumHeapBindings;
+};
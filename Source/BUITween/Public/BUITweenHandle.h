@@ -0,0 +1,252 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BUITweenInstance.h"
+
+class FBUITweenManager;
+
+// Stable reference to a tween living in an FBUITweenManager's pool.
+// Handles are cheap to copy and safe to keep around: once the tween completes or is cancelled the slot's
+// generation changes and every call through an old handle becomes a no-op.
+struct BUITWEEN_API FBUITweenHandle
+{
+public:
+	FBUITweenHandle() { }
+	FBUITweenHandle( int32 InIndex, uint32 InGeneration, FBUITweenManager* InManager = nullptr )
+		: Index( InIndex )
+		, Generation( InGeneration )
+		, Manager( InManager )
+	{
+	}
+
+	// Returns the instance this handle refers to, or nullptr if it has completed or been cancelled
+	FBUITweenInstance* Resolve() const;
+
+	// True while the tween has not completed or been cancelled
+	bool IsValid() const { return Resolve() != nullptr; }
+
+	void Reset() { Index = INDEX_NONE; Generation = 0; Manager = nullptr; }
+
+	int32 GetIndex() const { return Index; }
+	uint32 GetGeneration() const { return Generation; }
+	// The manager that created this tween
+	FBUITweenManager* GetManager() const { return Manager; }
+
+	inline bool operator==( const FBUITweenHandle& Other ) const
+	{
+		return Index == Other.Index && Generation == Other.Generation && Manager == Other.Manager;
+	}
+	inline bool operator!=( const FBUITweenHandle& Other ) const
+	{
+		return !( *this == Other );
+	}
+	friend inline uint32 GetTypeHash( const FBUITweenHandle& Handle )
+	{
+		return HashCombine( HashCombine( ::GetTypeHash( Handle.Index ), ::GetTypeHash( Handle.Generation ) ), ::GetTypeHash( Handle.Manager ) );
+	}
+
+	// Control
+	FBUITweenHandle& Begin();
+	// Removes the tween without firing OnComplete, returns false if the handle was already stale
+	bool Cancel();
+	FBUITweenHandle& Pause();
+	FBUITweenHandle& Resume();
+	bool IsPaused() const;
+	bool IsComplete() const;
+
+	// Builder, mirrors FBUITweenInstance
+	FBUITweenHandle& Easing( EBUIEasingType InType, TOptional<float> InEasingParam = TOptional<float>() )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->Easing( InType, InEasingParam );
+		return *this;
+	}
+
+	FBUITweenHandle& Easing( const UCurveFloat* InCurve )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->Easing( InCurve );
+		return *this;
+	}
+
+	FBUITweenHandle& EasingBezier( float X1, float Y1, float X2, float Y2 )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->EasingBezier( X1, Y1, X2, Y2 );
+		return *this;
+	}
+
+	FBUITweenHandle& ToTranslation( const FVector2D& InTarget )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->ToTranslation( InTarget );
+		return *this;
+	}
+	FBUITweenHandle& ToTranslation( float X, float Y )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->ToTranslation( X, Y );
+		return *this;
+	}
+	FBUITweenHandle& FromTranslation( const FVector2D& InStart )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->FromTranslation( InStart );
+		return *this;
+	}
+	FBUITweenHandle& FromTranslation( float X, float Y )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->FromTranslation( X, Y );
+		return *this;
+	}
+
+	FBUITweenHandle& ToScale( const FVector2D& InTarget )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->ToScale( InTarget );
+		return *this;
+	}
+	FBUITweenHandle& FromScale( const FVector2D& InStart )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->FromScale( InStart );
+		return *this;
+	}
+
+	FBUITweenHandle& ToOpacity( float InTarget )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->ToOpacity( InTarget );
+		return *this;
+	}
+	FBUITweenHandle& FromOpacity( float InStart )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->FromOpacity( InStart );
+		return *this;
+	}
+
+	FBUITweenHandle& ToColor( const FLinearColor& InTarget )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->ToColor( InTarget );
+		return *this;
+	}
+	FBUITweenHandle& FromColor( const FLinearColor& InStart )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->FromColor( InStart );
+		return *this;
+	}
+
+	FBUITweenHandle& ToRotation( float InTarget )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->ToRotation( InTarget );
+		return *this;
+	}
+	FBUITweenHandle& FromRotation( float InStart )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->FromRotation( InStart );
+		return *this;
+	}
+
+	FBUITweenHandle& ToMaxDesiredHeight( float InTarget )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->ToMaxDesiredHeight( InTarget );
+		return *this;
+	}
+	FBUITweenHandle& FromMaxDesiredHeight( float InStart )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->FromMaxDesiredHeight( InStart );
+		return *this;
+	}
+
+	FBUITweenHandle& ToCanvasPosition( FVector2D InTarget )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->ToCanvasPosition( InTarget );
+		return *this;
+	}
+	FBUITweenHandle& FromCanvasPosition( FVector2D InStart )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->FromCanvasPosition( InStart );
+		return *this;
+	}
+
+	FBUITweenHandle& ToPadding( const FMargin& InTarget )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->ToPadding( InTarget );
+		return *this;
+	}
+	FBUITweenHandle& FromPadding( const FMargin& InStart )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->FromPadding( InStart );
+		return *this;
+	}
+
+	FBUITweenHandle& ToVisibility( ESlateVisibility InTarget )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->ToVisibility( InTarget );
+		return *this;
+	}
+	FBUITweenHandle& FromVisibility( ESlateVisibility InStart )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->FromVisibility( InStart );
+		return *this;
+	}
+
+	FBUITweenHandle& OnStart( const FBUITweenSignature& InOnStart )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->OnStart( InOnStart );
+		return *this;
+	}
+	FBUITweenHandle& OnStart( FBUITweenSignature&& InOnStart )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->OnStart( MoveTemp( InOnStart ) );
+		return *this;
+	}
+	template<typename FunctorType, typename TEnableIf<!TIsSame<typename TDecay<FunctorType>::Type, FBUITweenSignature>::Value, int>::Type = 0>
+	FBUITweenHandle& OnStart( FunctorType&& InOnStart )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->OnStart( Forward<FunctorType>( InOnStart ) );
+		return *this;
+	}
+	FBUITweenHandle& OnComplete( const FBUITweenSignature& InOnComplete )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->OnComplete( InOnComplete );
+		return *this;
+	}
+	FBUITweenHandle& OnComplete( FBUITweenSignature&& InOnComplete )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->OnComplete( MoveTemp( InOnComplete ) );
+		return *this;
+	}
+	template<typename FunctorType, typename TEnableIf<!TIsSame<typename TDecay<FunctorType>::Type, FBUITweenSignature>::Value, int>::Type = 0>
+	FBUITweenHandle& OnComplete( FunctorType&& InOnComplete )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->OnComplete( Forward<FunctorType>( InOnComplete ) );
+		return *this;
+	}
+
+	FBUITweenHandle& EmulateLayout( bool bInEmulateLayout = true )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->EmulateLayout( bInEmulateLayout );
+		return *this;
+	}
+
+	FBUITweenHandle& Culling( EBUITweenCulling InCulling )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->Culling( InCulling );
+		return *this;
+	}
+
+	FBUITweenHandle& UpdateRate( EBUITweenUpdateRate InUpdateRate )
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->UpdateRate( InUpdateRate );
+		return *this;
+	}
+
+	FBUITweenHandle& ToReset()
+	{
+		if ( FBUITweenInstance* Instance = Resolve() ) Instance->ToReset();
+		return *this;
+	}
+
+	TWeakObjectPtr<UWidget> GetWidget() const
+	{
+		const FBUITweenInstance* Instance = Resolve();
+		return Instance ? Instance->GetWidget() : nullptr;
+	}
+
+private:
+	int32 Index = INDEX_NONE;
+	uint32 Generation = 0;
+	FBUITweenManager* Manager = nullptr;
+};
@@ -1,13 +1,16 @@
 #pragma once
 
 #include "BUIEasing.h"
+#include "BUITweenCallback.h"
 #include "Components/Widget.h"
 #include "BUITweenInstance.generated.h"
 
-DECLARE_DELEGATE_OneParam( FBUITweenSignature, UWidget* /*Owner*/ );
+class UCurveFloat;
 
 BUITWEEN_API DECLARE_LOG_CATEGORY_EXTERN(LogBUITween, Log, All);
 
+// A property track is only the description: From and To. The value a target actually starts from is kept
+// per target in FBUITweenTargetState, so one description can drive many widgets.
 template<typename T>
 class TBUITweenProp
 {
@@ -17,34 +20,24 @@ public:
 	inline bool IsSet() const { return bHasStart || bHasTarget; }
 	T StartValue;
 	T TargetValue;
-	T CurrentValue;
-	bool bIsFirstTime = true;
 	void SetStart( T InStart )
 	{
 		bHasStart = true;
 		StartValue = InStart;
-		CurrentValue = StartValue;
 	}
 	void SetTarget( T InTarget )
 	{
 		bHasTarget = true;
 		TargetValue = InTarget;
 	}
-	void OnBegin( T InCurrentValue )
+	// What a target currently holding InCurrentValue starts from
+	T GetStart( const T& InCurrentValue ) const
 	{
-		if ( !bHasStart )
-		{
-			StartValue = InCurrentValue;
-			CurrentValue = InCurrentValue;
-		}
+		return bHasStart ? StartValue : InCurrentValue;
 	}
-	bool Update( float Alpha )
+	T Evaluate( const T& InStart, float Alpha ) const
 	{
-		const T OldValue = CurrentValue;
-		CurrentValue = FMath::Lerp<T>( StartValue, TargetValue, Alpha );
-		const bool bShouldUpdate = bIsFirstTime || CurrentValue != OldValue;
-		bIsFirstTime = false;
-		return bShouldUpdate;
+		return FMath::Lerp<T>( InStart, TargetValue, Alpha );
 	}
 };
 
@@ -57,45 +50,217 @@ public:
 	inline bool IsSet() const { return bHasStart || bHasTarget; }
 	T StartValue;
 	T TargetValue;
-	T CurrentValue;
-	bool bIsFirstTime = true;
 	void SetStart( T InStart )
 	{
 		bHasStart = true;
 		StartValue = InStart;
-		CurrentValue = StartValue;
 	}
 	void SetTarget( T InTarget )
 	{
 		bHasTarget = true;
 		TargetValue = InTarget;
 	}
-	void OnBegin( T InCurrentValue )
+	T GetStart( const T& InCurrentValue ) const
 	{
-		if ( !bHasStart )
-		{
-			StartValue = InCurrentValue;
-			CurrentValue = InCurrentValue;
-		}
+		return bHasStart ? StartValue : InCurrentValue;
 	}
-	bool Update( float Alpha )
+	T Evaluate( const T& InStart, float Alpha ) const
 	{
-		const T OldValue = CurrentValue;
-		if ( Alpha >= 1 && bHasTarget )
-		{
-			CurrentValue = TargetValue;
-		}
-		else
-		{
-			CurrentValue = StartValue;
-		}
-		const bool bShouldChange = bIsFirstTime || OldValue != CurrentValue;
-		bIsFirstTime = false;
-		return bShouldChange;
+		return Alpha >= 1 && bHasTarget ? TargetValue : InStart;
 	}
 };
 
 
+enum class EBUITweenColorTarget : uint8
+{
+	None,
+	UserWidget,
+	Image,
+	Border,
+};
+
+enum class EBUITweenSlotTarget : uint8
+{
+	None,
+	CanvasPanel,
+	Overlay,
+	HorizontalBox,
+	VerticalBox,
+};
+
+// What a tween does while its widget can't be seen. Time keeps advancing either way, only the widget writes
+// are skipped. The last frame is always applied, so a tween that ends while hidden leaves its final values.
+enum class EBUITweenCulling : uint8
+{
+	// Use the group's policy, see FBUITweenManager::SetGroupCulling
+	Group,
+	// Always apply
+	None,
+	// Skip while hidden, apply the current value as soon as the widget shows again
+	CatchUp,
+	// Skip while hidden, complete the tween as soon as the widget shows again
+	Complete,
+};
+
+// How often a tween advances and writes its widget. Reduced rates step by the time since their last update,
+// so they still finish on time, just in fewer, larger steps. See also UBUITweenSettings::UpdateBudgetMs.
+enum class EBUITweenUpdateRate : uint8
+{
+	EveryFrame,
+	Hz30,
+	Hz15,
+};
+
+// Which setters Apply should call, resolved once in Begin so Apply can dispatch without casting
+struct FBUITweenSetterBinding
+{
+	// Raw pointer, only used while the owning widget is valid and still in this slot
+	UPanelSlot* Slot = nullptr;
+	EBUITweenColorTarget ColorTarget = EBUITweenColorTarget::None;
+	EBUITweenSlotTarget SlotTarget = EBUITweenSlotTarget::None;
+	bool bIsSizeBox = false;
+	// Canvas position and padding play as a render offset, see FBUITweenInstance::EmulateLayout
+	bool bEmulateLayout = false;
+};
+
+// Everything a tween keeps per target widget, the rest of FBUITweenInstance is a description that can be
+// shared. Start values are captured at Begin and only the tracks that are set are read.
+struct FBUITweenTargetState
+{
+	TWeakObjectPtr<UWidget> Widget;
+	FBUITweenSetterBinding Binding;
+
+	FVector2D Translation = FVector2D::ZeroVector;
+	FVector2D Scale = FVector2D::UnitVector;
+	FLinearColor Color = FLinearColor::White;
+	float Opacity = 1.0f;
+	float Rotation = 0;
+	FVector2D CanvasPosition = FVector2D::ZeroVector;
+	FVector4 Padding = FVector4( 0, 0, 0, 0 );
+	float MaxDesiredHeight = 0;
+	ESlateVisibility Visibility = ESlateVisibility::Visible;
+
+	// Visibility only changes at the ends of the tween, so it is only set when it differs from the last
+	// value applied
+	ESlateVisibility AppliedVisibility = ESlateVisibility::Visible;
+	bool bHasAppliedVisibility = false;
+
+	// Canvas position (XY) or padding an emulated layout track is showing while the slot still holds its old
+	// value, committed to the slot if the tween is cut short
+	FVector4 EmulatedLayout = FVector4( 0, 0, 0, 0 );
+	bool bHasEmulatedLayout = false;
+};
+
+// The value of each track for one target at one point of the tween, only the tracks that are set are
+// filled in. See FBUITweenInstance::Evaluate.
+struct FBUITweenValues
+{
+	FVector2D Translation;
+	FVector2D Scale;
+	FLinearColor Color;
+	float Opacity;
+	float Rotation;
+	FVector2D CanvasPosition;
+	FVector4 Padding;
+	float MaxDesiredHeight;
+	ESlateVisibility Visibility;
+};
+
+// Setter calls made versus skipped because the widget already held the value
+struct FBUITweenWriteCounters
+{
+	int32 Issued = 0;
+	int32 Skipped = 0;
+
+	void Reset()
+	{
+		Issued = 0;
+		Skipped = 0;
+	}
+};
+
+enum class EBUITweenWriteChannels : uint8
+{
+	None = 0,
+	Translation = 1 << 0,
+	Scale = 1 << 1,
+	Angle = 1 << 2,
+	Opacity = 1 << 3,
+};
+ENUM_CLASS_FLAGS( EBUITweenWriteChannels );
+
+// Combined contribution of the additive tweens on a widget. Translation and angle are offsets, scale and
+// opacity are multipliers, so the identity values leave the base untouched.
+struct FBUITweenLayerBlend
+{
+	FVector2D Translation = FVector2D::ZeroVector;
+	FVector2D Scale = FVector2D::UnitVector;
+	float Angle = 0;
+	float Opacity = 1.0f;
+	EBUITweenWriteChannels Channels = EBUITweenWriteChannels::None;
+};
+
+// What a widget's transform and opacity would be without its additive tweens, kept across frames by
+// UBUITween for every widget that has tweens
+struct BUITWEEN_API FBUITweenWidgetBase
+{
+	FWidgetTransform Transform;
+	float Opacity = 1.0f;
+	// What the widget held after our last flush. If the widget no longer matches, something else has set it
+	// and the widget's own value becomes the new base.
+	FWidgetTransform WrittenTransform;
+	float WrittenOpacity = 1.0f;
+	bool bIsValid = false;
+
+	// Set while the Slate fast path has put values on the SWidget that the UWidget's RenderTransform and
+	// RenderOpacity properties don't have yet. The properties still hold UMGTransform and UMGOpacity.
+	bool bIsUMGStale = false;
+	FWidgetTransform UMGTransform;
+	float UMGOpacity = 1.0f;
+
+	void Get( const UWidget* Target, FWidgetTransform& OutTransform, float& OutOpacity ) const;
+	// What the widget is showing, which is ahead of its UMG properties while they are stale. A UMG property
+	// that changed since the fast path took over means someone else set it, and that value is shown.
+	void GetDisplayed( const UWidget* Target, FWidgetTransform& OutTransform, float& OutOpacity ) const;
+	// Copies the values the fast path wrote into the UMG properties, once the widget stops tweening
+	void SyncUMG( UWidget* Target );
+};
+
+// Render transform and opacity gathered from every tween on one widget during an update, so the widget
+// gets at most one SetRenderTransform and one SetRenderOpacity per frame however many tweens it has
+struct BUITWEEN_API FBUITweenWidgetWrites
+{
+	// Differences below these are not visible, so the setter (and the invalidation it causes) is skipped
+	static constexpr float TranslationTolerance = 0.01f;
+	static constexpr float ScaleTolerance = 1.e-4f;
+	static constexpr float AngleTolerance = 0.01f;
+	static constexpr float OpacityTolerance = 1.0f / 1024.0f;
+	static constexpr float ColorTolerance = 1.0f / 1024.0f;
+	static constexpr float LayoutTolerance = 0.01f;
+
+	TWeakObjectPtr<UWidget> Widget;
+
+	// Absolute values from regular tweens, these replace the base. The last one applied wins.
+	FVector2D Translation = FVector2D::ZeroVector;
+	FVector2D Scale = FVector2D::UnitVector;
+	float Angle = 0;
+	float Opacity = 1.0f;
+	EBUITweenWriteChannels Channels = EBUITweenWriteChannels::None;
+
+	// Additive tweens still running, layered on top of the base for this frame only
+	FBUITweenLayerBlend Live;
+	// Additive tweens that finished this frame, folded into the base so their end state sticks
+	FBUITweenLayerBlend Settled;
+
+	// Set when a tween on the widget finished this frame, its final values are written even if they are
+	// within tolerance so the widget ends up exactly on the target
+	bool bExact = false;
+
+	// Writes base, then settled and live layers, to the widget and updates Base to match. With bWriteSlate
+	// the values go straight to the widget's SWidget and its UMG properties are left for SyncUMG.
+	void Flush( FBUITweenWidgetBase& Base, FBUITweenWriteCounters& Counters, bool bWriteSlate = false );
+};
+
 USTRUCT()
 struct BUITWEEN_API FBUITweenInstance
 {
@@ -103,32 +268,67 @@ struct BUITWEEN_API FBUITweenInstance
 
 public:
 	FBUITweenInstance() { }
-	FBUITweenInstance( UWidget* pInWidget, float InDuration, float InDelay = 0 )
-		: pWidget( pInWidget )
-		, Duration( InDuration )
-		, Delay( InDelay )
+	FBUITweenInstance( UWidget* pInWidget, bool bInIsAdditive = false )
+		: bIsAdditive( bInIsAdditive )
 	{
 		ensure( pInWidget != nullptr );
-
-	}
-	void Begin();
-	void Update( float InDeltaTime );
-	void Apply( float EasedAlpha );
+		State.Widget = pInWidget;
+	}
+	// One description applied to every widget in Targets, each starting InInterval after the one before.
+	// See FBUITweenManager::CreateStaggered.
+	FBUITweenInstance( TArrayView< UWidget* > Targets, float InTargetDuration, float InInterval, bool bInIsAdditive = false );
+	// Instances live in FBUITweenPool and are only ever moved into place, never copied
+	FBUITweenInstance( const FBUITweenInstance& ) = delete;
+	FBUITweenInstance& operator=( const FBUITweenInstance& ) = delete;
+	FBUITweenInstance( FBUITweenInstance&& ) = default;
+	FBUITweenInstance& operator=( FBUITweenInstance&& ) = default;
+
+	// Timing (alpha, delay, pause, completion) lives in UBUITween's timing stream, the instance only holds
+	// the property tracks, callbacks and the easing the tween was built with.
+	// BaseTransform and BaseOpacity are the widget's values without any additive layers, see FBUITweenWidgetBase
+	void Begin( const FWidgetTransform& BaseTransform, float BaseOpacity );
+
+	// Evaluates the tracks at EasedAlpha. Transform and opacity go into Writes and reach the widget when the
+	// caller flushes it, the other properties are written straight away but only if they changed.
+	void Apply( float EasedAlpha, bool bIsFinal, FBUITweenWidgetWrites& Writes, FBUITweenWriteCounters& Counters );
+
+	// Begin and Apply for one target of the description, Begin and Apply above use the instance's own target
+	void BeginTarget( FBUITweenTargetState& Target, const FWidgetTransform& BaseTransform, float BaseOpacity ) const;
+	void ApplyTarget( FBUITweenTargetState& Target, float EasedAlpha, bool bIsFinal, FBUITweenWidgetWrites& Writes, FBUITweenWriteCounters& Counters ) const;
+
+	// Apply in two halves. Evaluate is only math on the tracks and start values and touches no UObject, so it
+	// can run on any thread; ApplyValues writes the result to the widget on the game thread.
+	void Evaluate( float EasedAlpha, FBUITweenValues& OutValues ) const { EvaluateTarget( State, EasedAlpha, OutValues ); }
+	void EvaluateTarget( const FBUITweenTargetState& Target, float EasedAlpha, FBUITweenValues& OutValues ) const;
+	void ApplyValues( const FBUITweenValues& Values, bool bIsFinal, FBUITweenWidgetWrites& Writes, FBUITweenWriteCounters& Counters ) { ApplyTargetValues( State, Values, bIsFinal, Writes, Counters ); }
+	void ApplyTargetValues( FBUITweenTargetState& Target, const FBUITweenValues& Values, bool bIsFinal, FBUITweenWidgetWrites& Writes, FBUITweenWriteCounters& Counters ) const;
+
+	// Writes the layout value an emulated track was showing to the slot and drops its render offset, for a
+	// tween that is cancelled before its last frame
+	void CommitEmulatedLayout( FBUITweenTargetState& Target, FBUITweenWidgetWrites& Writes, FBUITweenWriteCounters& Counters ) const;
 
 	inline bool operator==( const FBUITweenInstance& other) const
 	{
-		return pWidget == other.pWidget;
+		return State.Widget == other.State.Widget;
 	}
-	bool IsComplete() const { return bIsComplete; }
 
 	// EasingParam is used for easing functions that have a second parameter, like Elastic
 	FBUITweenInstance& Easing( EBUIEasingType InType, TOptional<float> InEasingParam = TOptional<float>() )
 	{
 		EasingType = InType;
 		EasingParam = InEasingParam;
+		CustomEasing.Reset();
 		return *this;
 	}
 
+	// Ease along a designer-authored curve, its first to last key mapped onto the tween's duration. Baked
+	// into a shared table the first time a curve is used, so it costs the same as a built-in easing.
+	// Null goes back to the built-in easing type.
+	FBUITweenInstance& Easing( const UCurveFloat* InCurve );
+
+	// Ease along a CSS-style cubic-bezier( X1, Y1, X2, Y2 ), baked like a curve
+	FBUITweenInstance& EasingBezier( float X1, float Y1, float X2, float Y2 );
+
 	FBUITweenInstance& ToTranslation( const FVector2D& InTarget )
 	{
 		TranslationProp.SetTarget( InTarget );
@@ -241,12 +441,59 @@ public:
 
 	FBUITweenInstance& OnStart( const FBUITweenSignature& InOnStart )
 	{
-		OnStartedDelegate = InOnStart;
+		OnStartedDelegate.Set( InOnStart );
+		return *this;
+	}
+	FBUITweenInstance& OnStart( FBUITweenSignature&& InOnStart )
+	{
+		OnStartedDelegate.Set( MoveTemp( InOnStart ) );
+		return *this;
+	}
+	// Takes any functor callable with a UWidget*, small lambdas are stored without allocating
+	template<typename FunctorType, typename TEnableIf<!TIsSame<typename TDecay<FunctorType>::Type, FBUITweenSignature>::Value, int>::Type = 0>
+	FBUITweenInstance& OnStart( FunctorType&& InOnStart )
+	{
+		OnStartedDelegate.Set( Forward<FunctorType>( InOnStart ) );
 		return *this;
 	}
 	FBUITweenInstance& OnComplete( const FBUITweenSignature& InOnComplete )
 	{
-		OnCompleteDelegate = InOnComplete;
+		OnCompleteDelegate.Set( InOnComplete );
+		return *this;
+	}
+	FBUITweenInstance& OnComplete( FBUITweenSignature&& InOnComplete )
+	{
+		OnCompleteDelegate.Set( MoveTemp( InOnComplete ) );
+		return *this;
+	}
+	template<typename FunctorType, typename TEnableIf<!TIsSame<typename TDecay<FunctorType>::Type, FBUITweenSignature>::Value, int>::Type = 0>
+	FBUITweenInstance& OnComplete( FunctorType&& InOnComplete )
+	{
+		OnCompleteDelegate.Set( Forward<FunctorType>( InOnComplete ) );
+		return *this;
+	}
+
+	// Play canvas position and padding as a render translation from where the slot is, and only write the
+	// slot on the last frame. The panel lays out once at the end instead of every frame. Only used where an
+	// offset looks the same: canvas slots without stretched anchors, and padding that doesn't resize filled
+	// content. Neighbours in a box keep their place until the end.
+	FBUITweenInstance& EmulateLayout( bool bInEmulateLayout = true )
+	{
+		bEmulateLayout = bInEmulateLayout;
+		return *this;
+	}
+
+	// Skip widget writes while the widget is collapsed, hidden, scrolled out of a scroll box or not on screen
+	FBUITweenInstance& Culling( EBUITweenCulling InCulling )
+	{
+		CullingPolicy = InCulling;
+		return *this;
+	}
+
+	// For animations nobody looks at closely, background shimmer and the like
+	FBUITweenInstance& UpdateRate( EBUITweenUpdateRate InUpdateRate )
+	{
+		UpdateRateClass = InUpdateRate;
 		return *this;
 	}
 
@@ -260,28 +507,85 @@ public:
 		return *this;
 	}
 
-	TWeakObjectPtr<UWidget> GetWidget() const { return pWidget; }
+	// Null for staggered instances, their widgets are in GetStaggerTargets()
+	TWeakObjectPtr<UWidget> GetWidget() const { return State.Widget; }
+
+	bool IsStaggered() const { return StaggerTargets.Num() > 0; }
+	TArray< FBUITweenTargetState >& GetStaggerTargets() { return StaggerTargets; }
+	const TArray< FBUITweenTargetState >& GetStaggerTargets() const { return StaggerTargets; }
+	float GetStaggerInterval() const { return StaggerInterval; }
+	// Duration of each target, the tween itself lasts until the last target has finished
+	float GetStaggerTargetDuration() const { return StaggerTargetDuration; }
+	// Targets before this have finished and are not visited any more
+	int32 GetNumStaggerTargetsFinished() const { return NumStaggerTargetsFinished; }
+	void SetNumStaggerTargetsFinished( int32 InNum ) { NumStaggerTargetsFinished = InNum; }
+
+	bool IsAdditive() const { return bIsAdditive; }
+	bool IsEmulatingLayout() const { return bEmulateLayout; }
+	EBUITweenCulling GetCulling() const { return CullingPolicy; }
+	EBUITweenUpdateRate GetUpdateRate() const { return UpdateRateClass; }
+	// Seconds between updates, 0 for every frame
+	static float GetUpdateInterval( EBUITweenUpdateRate Rate )
+	{
+		switch ( Rate )
+		{
+		case EBUITweenUpdateRate::Hz30: return 1.0f / 30.0f;
+		case EBUITweenUpdateRate::Hz15: return 1.0f / 15.0f;
+		default: return 0;
+		}
+	}
+	// The widget this tween animates and its start values, unused when staggered
+	FBUITweenTargetState& GetTargetState() { return State; }
+
+	EBUIEasingType GetEasingType() const { return EasingType; }
+	const TOptional<float>& GetEasingParam() const { return EasingParam; }
+	// Baked curve or bezier easing, overrides the easing type when set
+	const FBUIEasingTablePtr& GetCustomEasing() const { return CustomEasing; }
+
+	void DoStartEvent()
+	{
+		OnStartedDelegate.ExecuteIfBound( State.Widget.Get() );
+	}
 
 	void DoCompleteCleanup()
 	{
 		if ( !bHasPlayedCompleteEvent )
 		{
-			OnCompleteDelegate.ExecuteIfBound( pWidget.Get() );
+			OnCompleteDelegate.ExecuteIfBound( State.Widget.Get() );
 			bHasPlayedCompleteEvent = true;
 		}
 	}
 
 protected:
-	bool bShouldUpdate = false;
-	bool bIsComplete = false;
+	static void ResolveWidgetBinding( UWidget* Target, FBUITweenSetterBinding& Binding );
+	static void ResolveSlotBinding( UWidget* Target, FBUITweenSetterBinding& Binding );
+	// Whether a render offset can stand in for this target's canvas position and padding tracks
+	bool CanEmulateLayout( const FBUITweenTargetState& Target ) const;
+	// How far the content of the target's slot moves if its padding becomes To, given how it is aligned
+	static FVector2D GetPaddingShift( const FBUITweenSetterBinding& Binding, const FVector4& To );
+
+	// The widget this tween animates and its start values, unused when staggered
+	FBUITweenTargetState State;
+
+	TArray< FBUITweenTargetState > StaggerTargets;
+	float StaggerInterval = 0;
+	float StaggerTargetDuration = 0;
+	int32 NumStaggerTargetsFinished = 0;
+
+	// Translation, scale, rotation and opacity are blended as a layer instead of replacing the widget's values.
+	// From/To are then offsets (translation, rotation) or multipliers (scale, opacity) and From defaults to
+	// no change. Other properties are applied as usual.
+	bool bIsAdditive = false;
 
-	TWeakObjectPtr<UWidget> pWidget = nullptr;
-	float Alpha = 0;
-	float Duration = 1;
-	float Delay = 0;
+	bool bEmulateLayout = false;
+
+	EBUITweenCulling CullingPolicy = EBUITweenCulling::Group;
+
+	EBUITweenUpdateRate UpdateRateClass = EBUITweenUpdateRate::EveryFrame;
 
 	EBUIEasingType EasingType = EBUIEasingType::InOutQuad;
 	TOptional<float> EasingParam;
+	FBUIEasingTablePtr CustomEasing;
 
 	TBUITweenProp<FVector2D> TranslationProp;
 	TBUITweenProp<FVector2D> ScaleProp;
@@ -293,10 +597,17 @@ protected:
 	TBUITweenInstantProp<ESlateVisibility> VisibilityProp;
 	TBUITweenProp<float> MaxDesiredHeightProp;
 
-	FBUITweenSignature OnStartedDelegate;
-	FBUITweenSignature OnCompleteDelegate;
+	FBUITweenCallback OnStartedDelegate;
+	FBUITweenCallback OnCompleteDelegate;
 
-	bool bHasPlayedStartEvent = false;
 	bool bHasPlayedCompleteEvent = false;
 };
 
+template<>
+struct TStructOpsTypeTraits<FBUITweenInstance> : public TStructOpsTypeTraitsBase2<FBUITweenInstance>
+{
+	enum
+	{
+		WithCopy = false,
+	};
+};
@@ -0,0 +1,429 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BUIEasing.h"
+#include "Components/Widget.h"
+#include "BUITweenInstance.h"
+#include "BUITweenHandle.h"
+#include "BUITweenPool.h"
+#include "BUITweenTimingStream.h"
+#include "BUITweenTimeline.h"
+
+// A timeline track that has started and not finished yet
+struct FBUITweenTimelineTrackRef
+{
+	uint32 Timeline;
+	int32 Track;
+
+	bool operator==( const FBUITweenTimelineTrackRef& Other ) const { return Timeline == Other.Timeline && Track == Other.Track; }
+};
+
+// Every live tween targeting one widget, so per-widget queries don't have to walk all tweens
+struct FBUITweenWidgetEntry
+{
+	TArray< FBUITweenHandle, TInlineAllocator<4> > Tweens;
+	// Timeline tracks only count while they play, from their start to their end
+	TArray< FBUITweenTimelineTrackRef, TInlineAllocator<1> > TimelineTracks;
+
+	// Transform and opacity underneath any additive tweens
+	FBUITweenWidgetBase Base;
+
+	// Index into FBUITweenManager::PendingWrites, only meaningful while PendingWriteFrame matches the current one
+	int32 PendingWrite = INDEX_NONE;
+	uint32 PendingWriteFrame = 0;
+
+	bool IsEmpty() const { return Tweens.Num() == 0 && TimelineTracks.Num() == 0; }
+};
+
+// Heap allocations made by BUITween's own storage during one frame
+struct FBUITweenAllocationCounters
+{
+	// Times the pool, timing streams, widget index, timeline playback or update scratch had to grow
+	int32 ContainerGrowths = 0;
+	// Callbacks that could not be stored inline, see FBUITweenCallback
+	int32 HeapCallbacks = 0;
+
+	int32 Num() const { return ContainerGrowths + HeapCallbacks; }
+};
+
+// A tween that finished this update and is waiting for its OnComplete
+struct FBUITweenCompletion
+{
+	uint32 Sequence;
+	int32 SlotIndex;
+
+	bool operator<( const FBUITweenCompletion& Other ) const { return Sequence < Other.Sequence; }
+};
+
+// A timeline handed to FBUITweenManager::Play, tracks sorted by start time
+struct FBUITweenTimelinePlayback
+{
+	uint32 Id = 0;
+	TArray< FBUITweenTimelineTrack > Tracks;
+	// Started and not finished yet, in start order. Reserved up front so playing never allocates.
+	TArray< int32 > ActiveTracks;
+	float Time = 0;
+	// Cursor, the first track that has not started yet
+	int32 NextTrack = 0;
+	// Removed at the end of the update
+	bool bIsFinished = false;
+};
+
+// A timeline track that finished this update and is waiting for its OnComplete
+struct FBUITweenTimelineCompletion
+{
+	int32 Timeline;
+	int32 Track;
+};
+
+// A run of rows in one group's running stream, the unit of work for FBUITweenManager::ComputeParallel
+struct FBUITweenParallelChunk
+{
+	int32 Group;
+	int32 BeginRow;
+	int32 EndRow;
+};
+
+// A begun tween waiting for its delay to run out, see FBUITweenGroup::DelayedStarts
+struct FBUITweenDelayedStart
+{
+	// Group clock time the delay runs out
+	double StartTime;
+	uint32 Sequence;
+	FBUITweenHandle Handle;
+
+	// Ties start in creation order
+	bool operator<( const FBUITweenDelayedStart& Other ) const
+	{
+		return StartTime < Other.StartTime || ( StartTime == Other.StartTime && Sequence < Other.Sequence );
+	}
+};
+
+// A running row whose apply waits for the update budget
+struct FBUITweenDeferredRow
+{
+	uint32 LastApplied;
+	int32 Group;
+	int32 Row;
+
+	// Longest waiting first, ties in a fixed order
+	bool operator<( const FBUITweenDeferredRow& Other ) const
+	{
+		if ( LastApplied != Other.LastApplied )
+		{
+			return LastApplied < Other.LastApplied;
+		}
+		return Group < Other.Group || ( Group == Other.Group && Row < Other.Row );
+	}
+};
+
+// Tweens sharing a time scale and pause state, see FBUITweenManager::SetGroupPaused.
+// Each group has its own timing streams, so skipping a paused group skips all of its rows at once.
+// A tween's row moves from Prepared to Delayed or Timings when it is begun, and from Delayed to Timings when
+// its delay runs out. Only Timings, the running tweens, is walked by Update. Finished tweens are released
+// and their rows compacted away at the end of the update.
+struct FBUITweenGroup
+{
+	FName Name;
+	FBUITweenTimingStream Prepared;
+	FBUITweenTimingStream Delayed;
+	FBUITweenTimingStream Timings;
+	// Min-heap on start time over the delayed tweens that aren't paused. Entries for tweens cancelled while
+	// delayed are left in and skipped when they come up.
+	TArray< FBUITweenDelayedStart > DelayedStarts;
+	// Live tweens in each set, rows flagged Removed don't count
+	int32 NumPerSet[ (int32)EBUITweenTimingSet::Num ] = {};
+	// Scaled time this group has run for, delays are measured against it
+	double Clock = 0;
+	float TimeScale = 1.0f;
+	bool bIsPaused = false;
+	// For tweens that don't set their own, never Group
+	EBUITweenCulling Culling = EBUITweenCulling::None;
+	// Set when a row is flagged Removed, so compaction can skip groups that haven't changed
+	bool bHasRemovedRows = false;
+
+	FBUITweenTimingStream& GetStream( EBUITweenTimingSet Set )
+	{
+		return Set == EBUITweenTimingSet::Running ? Timings : Set == EBUITweenTimingSet::Delayed ? Delayed : Prepared;
+	}
+	const FBUITweenTimingStream& GetStream( EBUITweenTimingSet Set ) const
+	{
+		return const_cast< FBUITweenGroup* >( this )->GetStream( Set );
+	}
+	int32& NumIn( EBUITweenTimingSet Set ) { return NumPerSet[ (int32)Set ]; }
+};
+
+// Owns a set of tweens and advances them when told to. UBUITween drives a default manager from the engine
+// tick; other managers can be created and stepped by hand, for tests, replays and benchmarks that need to run
+// many simulated frames in a tight loop with the same results every run.
+// Handles remember the manager that created them and must not be used after it is destroyed.
+class BUITWEEN_API FBUITweenManager
+{
+public:
+	FBUITweenManager();
+	~FBUITweenManager();
+	FBUITweenManager( const FBUITweenManager& ) = delete;
+	FBUITweenManager& operator=( const FBUITweenManager& ) = delete;
+
+	// Create a new tween on the target widget, does not start automatically.
+	// Non-additive tweens clear any existing tweens on the widget first. Additive tweens are layered on top of
+	// whatever else is tweening the widget, see FBUITweenInstance::bIsAdditive.
+	// InGroup is created on first use, NAME_None is the default group.
+	FBUITweenHandle Create( UWidget* pInWidget, float InDuration = 1.0f, float InDelay = 0.0f, bool bIsAdditive = false, FName InGroup = NAME_None );
+
+	// One tween for a whole list of widgets, each lasting InDuration and starting InPerItemDelay after the one
+	// before. Build and control it through the handle like any other tween; OnStart fires as the first widget
+	// starts and OnComplete once the last one has finished, both with a null widget.
+	// The properties and easing are stored once for the list, each widget only keeps its start values, and
+	// widgets at the same point in their animation share one easing evaluation. Clearing any of the widgets
+	// cancels the whole tween.
+	FBUITweenHandle CreateStaggered( TArrayView< UWidget* > Widgets, float InDuration, float InPerItemDelay, float InDelay = 0.0f, bool bIsAdditive = false, FName InGroup = NAME_None );
+
+	// Cancel all tweens on the target widget, returns the number of tween instances removed. Timeline tracks
+	// playing on the widget are stopped and counted too, the rest of their timeline keeps playing.
+	int32 Clear( UWidget* pInWidget );
+
+	// Snapshots the widget's current state and starts the tween's clock
+	void Begin( FBUITweenHandle Handle );
+
+	// Cancel a single tween without firing its OnComplete, returns false if the handle was stale
+	bool Cancel( FBUITweenHandle Handle );
+
+	void SetPaused( FBUITweenHandle Handle, bool bInPaused );
+	bool IsPaused( FBUITweenHandle Handle ) const;
+
+	// Returns nullptr once the tween has completed or been cancelled
+	FBUITweenInstance* GetInstance( FBUITweenHandle Handle ) const;
+
+	// Advances every begun tween. Callback ordering within one update:
+	//  - OnStart fires during the apply pass, before that tween's first values are applied
+	//  - All widget writes for the update are made before any OnComplete fires
+	//  - Every tween finishing this update is released before the first OnComplete, so GetIsTweening and
+	//    handles already see them as done, then OnComplete fires in the order the tweens were created
+	//  - A queued OnComplete still fires if an earlier callback cancels or clears that tween
+	//  - Tweens created or begun inside a callback are not advanced until the next update
+	void Update( float InDeltaTime );
+
+	// With a fixed step, Step() banks DeltaTime and runs one Update( FixedStep ) per whole step, at most
+	// MaxSubsteps per call; anything left over past that is dropped so a long hitch can't snowball. The
+	// result then only depends on how much time has passed, not how it was split into frames.
+	// A step of 0 (the default) makes Step() a plain Update( DeltaTime ).
+	void SetFixedStep( float InFixedStep, int32 InMaxSubsteps = 8 );
+	float GetFixedStep() const { return FixedStep; }
+
+	// Returns the number of updates run
+	int32 Step( float DeltaTime );
+
+	// Runs updates until GetTime() reaches InTime, in whole fixed steps if one is set, ignoring MaxSubsteps.
+	// Returns the number of updates run. Only seeks forwards: tweens can't be rewound once their callbacks
+	// have run, so a time before GetTime() trips an ensure and does nothing.
+	int32 SeekTo( double InTime );
+
+	// Total time passed to Update
+	double GetTime() const { return Time; }
+
+	// Groups. Time scale and pause apply on top of each tween's own pause. A paused group is skipped by
+	// Update without visiting its tweens. Cancel and complete only walk the tweens in the group.
+	void SetGroupTimeScale( FName InGroup, float InTimeScale );
+	float GetGroupTimeScale( FName InGroup ) const;
+	void SetGroupPaused( FName InGroup, bool bInPaused );
+	bool IsGroupPaused( FName InGroup ) const;
+	// Culling for the group's tweens that are left on EBUITweenCulling::Group
+	void SetGroupCulling( FName InGroup, EBUITweenCulling InCulling );
+	EBUITweenCulling GetGroupCulling( FName InGroup ) const;
+	// Cancels every tween in the group without firing OnComplete, returns the number removed
+	int32 CancelGroup( FName InGroup );
+	// Runs every begun tween in the group to its end and fires OnComplete, even if the group or the tween is
+	// paused or still waiting out its delay. Tweens begun by those OnComplete callbacks are completed too.
+	void CompleteGroup( FName InGroup );
+	// Number of tweens in the group, including ones that have not started yet
+	int32 GetGroupNum( FName InGroup ) const;
+
+	// Starts building a timeline that plays in this manager, see FBUITweenTimeline
+	FBUITweenTimeline Sequence() { return FBUITweenTimeline( this ); }
+
+	// Timelines advance with Update, not with any group, and their tracks' OnComplete fire after those of
+	// regular tweens finishing in the same update. A track counts as tweening its widget while it plays, and
+	// a non-additive one clears the widget's other tweens when it starts, like Create.
+	FBUITweenTimelineHandle Play( FBUITweenTimeline&& Timeline );
+	bool StopTimeline( FBUITweenTimelineHandle Handle );
+	bool IsTimelinePlaying( FBUITweenTimelineHandle Handle ) const;
+
+	bool GetIsTweening( UWidget* pInWidget ) const;
+
+	// Appends the handles of every tween on the target widget, including ones that have not started yet
+	void GetTweens( UWidget* pInWidget, TArray< FBUITweenHandle >& OutHandles ) const;
+	// Appends every timeline with a track playing on the target widget, once per track
+	void GetTimelines( UWidget* pInWidget, TArray< FBUITweenTimelineHandle >& OutHandles ) const;
+
+	// CompleteGroup for every group, and finishes every timeline
+	void CompleteAll();
+
+	// Cancels every tween without callbacks and releases the per-update scratch storage. Tween slots are
+	// kept so that handles from before stay stale.
+	void Empty();
+
+	int32 Num() const { return Pool.Num(); }
+
+	// Setter calls issued and skipped by the most recent Update, plus any Begin calls made since
+	const FBUITweenWriteCounters& GetWriteCounters() const { return WriteCounters; }
+	// Tweens whose widget writes the most recent Update skipped because the widget couldn't be seen
+	int32 GetNumCulled() const { return NumCulled; }
+	// Reduced-rate tweens the most recent Update left for later because it ran out of budget, see
+	// UBUITweenSettings::UpdateBudgetMs
+	int32 GetNumOverBudget() const { return NumOverBudget; }
+
+	// Allocations made from the end of the previous Update to the end of the most recent one. Stays at zero
+	// once storage has grown to the peak number of live tweens, see UBUITweenSettings::InitialTweenCapacity.
+	const FBUITweenAllocationCounters& GetAllocationCounters() const { return FrameAllocations; }
+
+	// Bytes held by the pool, timing stream, widget index and update scratch
+	SIZE_T GetAllocatedSize() const;
+
+protected:
+	// Invalidates the handle and drops it from the widget index
+	bool Release( FBUITweenHandle Handle );
+	// Writes the layout values a cancelled tween was emulating to its slots, see FBUITweenInstance::EmulateLayout
+	void CommitEmulatedLayout( FBUITweenInstance& Instance );
+	// Drops the handle from the index entry of every widget the instance targets, apart from pExcept
+	void RemoveFromWidgetIndex( const FBUITweenInstance& Instance, FBUITweenHandle Handle, const UWidget* pExcept = nullptr );
+	// Invalidates the handle and flags its timing row for removal, leaves the widget index alone
+	bool RemoveFromTimings( FBUITweenHandle Handle );
+	// Clear(), leaving the tracks of KeepTimeline playing. Timeline ids start at 1, 0 keeps none.
+	int32 ClearWidget( UWidget* pInWidget, uint32 KeepTimeline );
+	void AddTrackToWidgetIndex( const FBUITweenTimelinePlayback& Timeline, int32 TrackIndex );
+	void RemoveTrackFromWidgetIndex( const FBUITweenTimelinePlayback& Timeline, int32 TrackIndex );
+
+	// The stream holding the tween's row, see FBUITweenGroup
+	FBUITweenTimingStream& GetTimings( FBUITweenHandle Handle );
+	const FBUITweenTimingStream& GetTimings( FBUITweenHandle Handle ) const;
+	// Copies the tween's row into another of its group's streams and flags the old one for removal, returns
+	// the new row
+	int32 MoveTiming( FBUITweenHandle Handle, EBUITweenTimingSet To );
+	// Puts a delayed tween in the start heap, due InDelay from now
+	void ScheduleStart( FBUITweenHandle Handle, float InDelay );
+	// Takes a delayed tween out of the start heap, returns the time it had left or a negative value if it
+	// wasn't scheduled
+	float UnscheduleStart( FBUITweenHandle Handle );
+	// Moves every tween due by the group's clock into its running stream. Each starts with however much
+	// of GroupDeltaTime was left after its delay, so the advance pass adding GroupDeltaTime lands it on the
+	// exact time since its start.
+	void StartDueTweens( int32 GroupIndex, float GroupDeltaTime );
+
+	// Advances, eases and evaluates the first NumRows running rows of each group with ParallelFor, filling
+	// ComputedValues. Used instead of the serial advance and ease passes once enough tweens are running, see
+	// UBUITweenSettings::ParallelUpdateThreshold. A tween's first frame is evaluated again by ApplyRow after
+	// its OnStart has run.
+	void ComputeParallel( TArrayView< const int32 > NumRows, TArrayView< const float > GroupDeltaTimes );
+
+	// Whether any of the widget can be seen, see EBUITweenCulling. Cached per widget for the update.
+	bool IsShown( const UWidget* Widget );
+
+	// Applies the property tracks of one running row whose time has advanced, firing OnStart first if needed
+	void ApplyRow( int32 GroupIndex, int32 Row, bool bParallel );
+
+	// Applies a staggered instance for the tween's elapsed time, reading its easing from the timing row.
+	// bApplyPending also applies targets that haven't started yet, for their starting conditions at Begin.
+	// bCull skips targets that can't be seen, each one catches up when it shows again.
+	void ApplyStaggered( FBUITweenInstance& Instance, const FBUITweenTimingStream& Timings, int32 Row, bool bApplyPending, bool bCull = false );
+
+	// Advances every unpaused group. With bComplete every running, delayed or paused tween in OnlyGroup, or
+	// in every group, jumps to its end instead and timelines finish.
+	void Tick( float DeltaTime, bool bComplete = false, int32 OnlyGroup = INDEX_NONE );
+	// Completion passes until one leaves nothing begun in the groups, see CompleteGroup
+	void CompleteGroups( int32 OnlyGroup );
+	// Whether a completion pass over OnlyGroup, or every group, would have anything to finish
+	bool HasTweensToComplete( int32 OnlyGroup ) const;
+	// Moves every delayed tween in the group into its running stream, paused or not
+	void StartAllDelayed( int32 GroupIndex );
+
+	// Starts every track that is due and applies the active ones, for the first NumTimelines timelines
+	void AdvanceTimelines( float DeltaTime, int32 NumTimelines );
+	// Applies the timeline's active tracks at time At and finishes the ones that end by then. With
+	// bOnlyFinishing the others are left alone. Returns the number finished.
+	int32 ApplyTimelineTracks( int32 TimelineIndex, float At, bool bOnlyFinishing );
+	FBUITweenTimelinePlayback* FindTimeline( FBUITweenTimelineHandle Handle ) const;
+
+	int32 FindOrAddGroup( FName InGroup );
+	const FBUITweenGroup* FindGroup( FName InGroup ) const;
+
+	void OnPostGarbageCollect();
+
+	void Reserve();
+
+	// Counted where they happen rather than by measuring every container before and after, see
+	// FBUITweenAllocationCounters
+	template< typename ArrayType >
+	void CountGrowth( const ArrayType& Array, int32 NewNum )
+	{
+		if ( NewNum > Array.Max() )
+		{
+			PendingAllocations.ContainerGrowths++;
+		}
+	}
+	// Growths of the pool and every group's streams so far, they keep their own running totals
+	int32 GetNumStorageGrowths() const;
+	FBUITweenWidgetEntry& FindOrAddWidgetEntry( UWidget* pInWidget );
+
+	// Transform and opacity accumulator for the widget this frame, shared by every tween on it
+	FBUITweenWidgetWrites& GetPendingWrites( UWidget* pInWidget );
+	// Writes every accumulated transform and opacity to its widget
+	void FlushWrites();
+	// FlushWrites, unless an update is running, whose own flush then writes these with the rest of its frame
+	void FlushWritesOutsideUpdate();
+
+	// Owns every instance, the timing stream rows refer into it by slot index
+	FBUITweenPool Pool;
+
+	// One timing stream per group, with one row per live tween. Rows added while Update is running are not
+	// advanced until the next update. Groups are never removed, so indices stay valid.
+	TArray< FBUITweenGroup > Groups;
+	TMap< FName, int32 > GroupIndices;
+
+	// Keyed by the weak pointer so entries for destroyed widgets can be found and pruned after GC
+	TMap< TWeakObjectPtr<UWidget>, FBUITweenWidgetEntry > WidgetTweens;
+	FDelegateHandle PostGarbageCollectHandle;
+
+	// Filled by ComputeParallel, one entry per running row starting at GroupValueOffsets[ Group ]. Kept around
+	// so steady-state updates don't allocate.
+	TArray< FBUITweenValues > ComputedValues;
+	TArray< int32 > GroupValueOffsets;
+	TArray< FBUITweenParallelChunk > ParallelChunks;
+
+	TArray< FBUITweenWidgetWrites > PendingWrites;
+	// Bumped by every flush, so entries don't need resetting to forget their PendingWrite
+	uint32 WriteFrame = 1;
+	FBUITweenWriteCounters WriteCounters;
+	int32 NumCulled = 0;
+	// Culling result for every widget checked so far in the current update, and every parent on the way
+	TMap< const UWidget*, bool > ShownThisUpdate;
+
+	// Reduced-rate rows waiting for the budget in the current update
+	TArray< FBUITweenDeferredRow > DeferredRows;
+	int32 NumOverBudget = 0;
+	// Counts updates, for FBUITweenTimingStream::LastApplied
+	uint32 UpdateNumber = 0;
+
+	// Playback objects are heap allocated so they stay put while their track callbacks run. Finished ones
+	// are removed at the end of the outermost update, so indices are stable until then.
+	TArray< TUniquePtr< FBUITweenTimelinePlayback > > Timelines;
+	TArray< FBUITweenTimelineCompletion > TimelineCompletions;
+	uint32 NextTimelineId = 1;
+
+	// Filled by the completion pass and dispatched after it, kept around so steady-state updates don't allocate
+	TArray< FBUITweenCompletion > CompletionQueue;
+	uint32 NextSequence = 0;
+	int32 UpdateDepth = 0;
+
+	// Counted since the last Update finished, published to FrameAllocations when it does
+	FBUITweenAllocationCounters PendingAllocations;
+	FBUITweenAllocationCounters FrameAllocations;
+	int32 LastNumHeapBindings = 0;
+	int32 LastNumStorageGrowths = 0;
+
+	double Time = 0;
+	float FixedStep = 0;
+	int32 MaxSubsteps = 8;
+	// Time banked by Step() that doesn't make up a whole fixed step yet
+	float StepAccumulator = 0;
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+#include "BUITweenInstance.h"
+#include "BUITweenHandle.h"
+#include "BUITweenTimingStream.h"
+
+// Slot map that owns every tween instance.
+// Slots are allocated in fixed-size chunks that never move, so an instance stays at the same address from
+// Create until it is released and is never copied. Handles carry a generation so stale ones resolve to nullptr.
+class BUITWEEN_API FBUITweenPool
+{
+public:
+	// Owner is stamped into every handle the pool hands out
+	explicit FBUITweenPool( FBUITweenManager* InOwner = nullptr )
+		: Owner( InOwner )
+	{
+	}
+	FBUITweenPool( const FBUITweenPool& ) = delete;
+	FBUITweenPool& operator=( const FBUITweenPool& ) = delete;
+
+	// Constructs a new instance in a free slot
+	FBUITweenHandle Add( UWidget* pInWidget, bool bIsAdditive = false )
+	{
+		return Add( FBUITweenInstance( pInWidget, bIsAdditive ) );
+	}
+	FBUITweenHandle Add( FBUITweenInstance&& InInstance );
+
+	// Invalidates the handle. The slot is not reused until ReleasePendingSlots(), so an instance that is
+	// removed while one of its own callbacks is running stays intact until the end of the update.
+	bool Remove( FBUITweenHandle Handle );
+
+	void ReleasePendingSlots();
+
+	FBUITweenInstance* Get( FBUITweenHandle Handle ) const
+	{
+		if ( Handle.GetManager() != Owner || Handle.GetIndex() < 0 || Handle.GetIndex() >= NumSlots )
+		{
+			return nullptr;
+		}
+		FSlot& Slot = GetSlot( Handle.GetIndex() );
+		return Slot.Generation == Handle.GetGeneration() ? &Slot.Instance : nullptr;
+	}
+
+	// Row in FBUITweenTimingStream holding this tween's timing, INDEX_NONE for stale handles
+	int32 GetTimingRow( FBUITweenHandle Handle ) const
+	{
+		return Get( Handle ) ? GetSlot( Handle.GetIndex() ).TimingRow : INDEX_NONE;
+	}
+	void SetTimingRow( int32 SlotIndex, int32 Row )
+	{
+		GetSlot( SlotIndex ).TimingRow = Row;
+	}
+	// Group whose timing stream holds the row, see FBUITweenManager
+	int32 GetTimingGroup( FBUITweenHandle Handle ) const
+	{
+		return Get( Handle ) ? GetSlot( Handle.GetIndex() ).TimingGroup : INDEX_NONE;
+	}
+	void SetTimingGroup( int32 SlotIndex, int32 Group )
+	{
+		GetSlot( SlotIndex ).TimingGroup = Group;
+	}
+	// Which of the group's streams holds the row
+	EBUITweenTimingSet GetTimingSet( FBUITweenHandle Handle ) const
+	{
+		return Get( Handle ) ? GetSlot( Handle.GetIndex() ).TimingSet : EBUITweenTimingSet::Prepared;
+	}
+	void SetTimingSet( int32 SlotIndex, EBUITweenTimingSet Set )
+	{
+		GetSlot( SlotIndex ).TimingSet = Set;
+	}
+
+	// Direct slot access for the update loop, which walks the timing stream by slot index
+	FBUITweenInstance& GetInstanceAt( int32 SlotIndex ) const
+	{
+		return GetSlot( SlotIndex ).Instance;
+	}
+	FBUITweenHandle GetHandleAt( int32 SlotIndex ) const
+	{
+		return FBUITweenHandle( SlotIndex, GetSlot( SlotIndex ).Generation, Owner );
+	}
+
+	// Allocates chunks and bookkeeping up front so the first NumTweens live tweens don't allocate
+	void Reserve( int32 NumTweens );
+
+	// Releases every instance. Chunks are kept, so handles from before Empty() never resolve again.
+	void Empty();
+
+	int32 Num() const { return NumUsed; }
+
+	// Times a chunk or the free list has had to be allocated since the pool was created. Reserve() doesn't count.
+	int32 GetNumGrowths() const { return NumGrowths; }
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Chunks.Num() * SlotsPerChunk * sizeof( FSlot ) + Chunks.GetAllocatedSize()
+			+ FreeSlots.GetAllocatedSize() + SlotsPendingRelease.GetAllocatedSize();
+	}
+
+private:
+	enum { SlotsPerChunk = 128 };
+
+	struct FSlot
+	{
+		FBUITweenInstance Instance;
+		// Odd while the slot is in use, so a live handle never matches a free slot
+		uint32 Generation = 0;
+		int32 TimingRow = INDEX_NONE;
+		int32 TimingGroup = 0;
+		EBUITweenTimingSet TimingSet = EBUITweenTimingSet::Prepared;
+	};
+
+	FSlot& GetSlot( int32 Index ) const
+	{
+		return Chunks[ Index / SlotsPerChunk ][ Index % SlotsPerChunk ];
+	}
+
+	FBUITweenManager* Owner;
+	TArray< TUniquePtr< FSlot[] > > Chunks;
+	TArray< int32 > FreeSlots;
+	TArray< int32 > SlotsPendingRelease;
+	int32 NumSlots = 0;
+	int32 NumUsed = 0;
+	int32 NumGrowths = 0;
+};
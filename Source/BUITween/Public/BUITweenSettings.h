@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "BUITweenSettings.generated.h"
+
+UENUM()
+enum class EBUIEasingTableInterpolation : uint8
+{
+	Linear,
+	// Cubic Hermite using the curve's slope at each sample, needs far fewer samples for the same error
+	Hermite,
+};
+
+// Project-wide tweening options, found under Project Settings > Plugins > BUITween
+UCLASS( config = Game, defaultconfig, meta = ( DisplayName = "BUITween" ) )
+class BUITWEEN_API UBUITweenSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	virtual FName GetCategoryName() const override { return TEXT( "Plugins" ); }
+
+	// Bake each easing curve into a lookup table the first time it is used instead of evaluating sin/pow
+	// every frame. Only affects tweens started after the setting changes.
+	UPROPERTY( config, EditAnywhere, Category = "Easing" )
+	bool bUseEasingLookupTables = false;
+
+	UPROPERTY( config, EditAnywhere, Category = "Easing", meta = ( EditCondition = "bUseEasingLookupTables" ) )
+	EBUIEasingTableInterpolation EasingTableInterpolation = EBUIEasingTableInterpolation::Hermite;
+
+	// Number of intervals a table starts with
+	UPROPERTY( config, EditAnywhere, Category = "Easing", meta = ( EditCondition = "bUseEasingLookupTables", ClampMin = "4", ClampMax = "65536" ) )
+	int32 EasingTableResolution = 64;
+
+	// Largest allowed difference from the analytic curve. Resolution is doubled at bake time until the
+	// table is within this error or reaches MaxEasingTableResolution.
+	UPROPERTY( config, EditAnywhere, Category = "Easing", meta = ( EditCondition = "bUseEasingLookupTables", ClampMin = "0.000001" ) )
+	float MaxEasingTableError = 0.002f;
+
+	UPROPERTY( config, EditAnywhere, Category = "Easing", meta = ( EditCondition = "bUseEasingLookupTables", ClampMin = "4", ClampMax = "65536" ) )
+	int32 MaxEasingTableResolution = 4096;
+
+	// Tween storage is allocated for this many simultaneous tweens at startup. Creating and finishing tweens
+	// doesn't allocate until more than this are alive at once.
+	UPROPERTY( config, EditAnywhere, Category = "Performance", meta = ( ClampMin = "0" ) )
+	int32 InitialTweenCapacity = 256;
+
+	// Once this many tweens are running, advancing time, easing and evaluating the property tracks is spread
+	// over worker threads. Widgets are still only written on the game thread. 0 keeps it all on the game thread.
+	UPROPERTY( config, EditAnywhere, Category = "Performance", meta = ( ClampMin = "0" ) )
+	int32 ParallelUpdateThreshold = 0;
+
+	// Write render transform and opacity straight to each widget's SWidget, and only copy them into the
+	// UWidget's RenderTransform and RenderOpacity properties once the widget's last tween completes or is
+	// cancelled. Code reading those properties mid-tween sees the values from before the tween.
+	UPROPERTY( config, EditAnywhere, Category = "Performance" )
+	bool bWriteSlateDirectly = false;
+
+	// Milliseconds each update may spend applying tweens with a reduced UpdateRate, after everything else has
+	// been advanced and applied. Only that apply loop is timed: advancing, easing, full-rate tweens, timelines,
+	// writing to the widgets and callbacks don't count against it. The ones left over go first in later
+	// updates, longest waiting first, and catch up on the time they missed. At least one is applied per update.
+	// Full-rate tweens and the last frame of any tween are always applied. 0 for no budget.
+	UPROPERTY( config, EditAnywhere, Category = "Performance", meta = ( ClampMin = "0" ) )
+	float UpdateBudgetMs = 0;
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BUIEasing.h"
+#include "BUITweenInstance.h"
+
+class FBUITweenManager;
+
+// One step of a compiled timeline, Start is relative to the start of the timeline
+struct FBUITweenTimelineTrack
+{
+	float Start = 0;
+	float Duration = 0;
+	// Resolved when the timeline is played, like the timing stream does at Begin
+	FBUIEasingFunction EasingFunction = nullptr;
+	float EasingParam = 0.1f;
+	// Curve or bezier easing, or the baked built-in one with UBUITweenSettings::bUseEasingLookupTables
+	FBUIEasingTablePtr EasingTable;
+	FBUITweenInstance Instance;
+};
+
+// Refers to a timeline playing in an FBUITweenManager, goes stale once every track has finished or the
+// timeline is stopped
+struct BUITWEEN_API FBUITweenTimelineHandle
+{
+public:
+	FBUITweenTimelineHandle() { }
+	FBUITweenTimelineHandle( uint32 InId, FBUITweenManager* InManager )
+		: Id( InId )
+		, Manager( InManager )
+	{
+	}
+
+	bool IsPlaying() const;
+
+	// Stops the timeline where it is, tracks still running don't fire OnComplete
+	bool Stop();
+
+	uint32 GetId() const { return Id; }
+	FBUITweenManager* GetManager() const { return Manager; }
+
+private:
+	uint32 Id = 0;
+	FBUITweenManager* Manager = nullptr;
+};
+
+// Builds a timeline out of tracks that play one after another (Then), alongside the previous step (With)
+// or spread over a list of widgets (Stagger). Play() compiles them into a single list sorted by start
+// time, which the manager walks with one cursor. A track starts on the update its start time is reached,
+// with the rest of that update's time already applied, so there is no frame gap between steps, and
+// nothing is created or allocated per step while the timeline plays.
+//
+//	UBUITween::Sequence()
+//		.Then( Panel, 0.2f, []( FBUITweenInstance& T ) { T.FromOpacity( 0 ).ToOpacity( 1 ); } )
+//		.With( Title, 0.2f, []( FBUITweenInstance& T ) { T.FromTranslation( 0, -20 ).ToTranslation( 0, 0 ); } )
+//		.Stagger( Rows, 0.15f, 0.03f, []( FBUITweenInstance& T ) { T.FromOpacity( 0 ).ToOpacity( 1 ); } )
+//		.Play();
+class BUITWEEN_API FBUITweenTimeline
+{
+public:
+	// Called once per track when it is added, to set up its properties, easing and callbacks
+	typedef TFunctionRef< void( FBUITweenInstance& ) > FSetup;
+
+	explicit FBUITweenTimeline( FBUITweenManager* InManager )
+		: Manager( InManager )
+	{
+	}
+	FBUITweenTimeline( FBUITweenTimeline&& ) = default;
+	FBUITweenTimeline& operator=( FBUITweenTimeline&& ) = default;
+	FBUITweenTimeline( const FBUITweenTimeline& ) = delete;
+	FBUITweenTimeline& operator=( const FBUITweenTimeline& ) = delete;
+
+	// Starts once everything added so far has finished
+	FBUITweenTimeline& Then( UWidget* pInWidget, float InDuration, FSetup Setup );
+
+	// Starts together with the previous Then or Stagger
+	FBUITweenTimeline& With( UWidget* pInWidget, float InDuration, FSetup Setup );
+
+	// Starts once everything added so far has finished, one track per widget, each InInterval after the last
+	FBUITweenTimeline& Stagger( TArrayView< UWidget* > Widgets, float InDuration, float InInterval, FSetup Setup );
+
+	// Leaves a gap before the next Then or Stagger
+	FBUITweenTimeline& Wait( float InSeconds );
+
+	float GetDuration() const { return End; }
+	int32 Num() const { return Tracks.Num(); }
+
+	// Hands the tracks to the manager and starts playing, the builder is left empty
+	FBUITweenTimelineHandle Play();
+
+private:
+	friend class FBUITweenManager;
+
+	void AddTrack( UWidget* pInWidget, float InStart, float InDuration, FSetup& Setup );
+
+	FBUITweenManager* Manager;
+	TArray< FBUITweenTimelineTrack > Tracks;
+	// Start of the most recent Then or Stagger, With tracks start here too
+	float StepStart = 0;
+	float End = 0;
+};
@@ -0,0 +1,239 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BUIEasing.h"
+#include "BUIEasingTable.h"
+
+// Which of its group's streams a tween's timing row is in, see FBUITweenGroup
+enum class EBUITweenTimingSet : uint8
+{
+	// Created, Begin() not called yet
+	Prepared,
+	// Begun and waiting out its delay
+	Delayed,
+	// Advanced by every update of its group
+	Running,
+
+	Num,
+};
+
+enum class EBUITweenTimingFlags : uint8
+{
+	None = 0,
+	Paused = 1 << 0,
+	// OnStart has fired
+	Started = 1 << 1,
+	Complete = 1 << 2,
+	// Advanced this frame, the property tracks need to be applied
+	NeedsApply = 1 << 3,
+	HasEasingParam = 1 << 4,
+	// Completed, cancelled or moved to another stream, the row is compacted away at the end of the update
+	Removed = 1 << 5,
+	// Skipped by culling last time it advanced, see EBUITweenCulling
+	Culled = 1 << 6,
+};
+ENUM_CLASS_FLAGS( EBUITweenTimingFlags );
+
+// Hot per-tween timing state, stored as parallel arrays indexed by row.
+// Advancing time only ever touches these arrays; property tracks, delegates and the widget pointer stay
+// in the pooled FBUITweenInstance that SlotIndex refers to.
+struct BUITWEEN_API FBUITweenTimingStream
+{
+public:
+	int32 Add( int32 InSlotIndex, float InDuration, float InDelay, uint32 InSequence )
+	{
+		CountGrowth();
+		Alpha.Add( 0 );
+		Duration.Add( InDuration );
+		Delay.Add( InDelay );
+		EasedAlpha.Add( 0 );
+		EasingParam.Add( 0.1f );
+		EasingPeriod.Add( 1.0f );
+		EasingType.Add( EBUIEasingType::InOutQuad );
+		EasingFunction.Add( nullptr );
+		EasingTable.Add( nullptr );
+		Flags.Add( EBUITweenTimingFlags::None );
+		Sequence.Add( InSequence );
+		UpdateInterval.Add( 0 );
+		UpdateCountdown.Add( 0 );
+		PendingTime.Add( 0 );
+		LastApplied.Add( 0 );
+		return SlotIndex.Add( InSlotIndex );
+	}
+
+	// Appends a copy of Other's row, returns the new row
+	int32 AddFrom( const FBUITweenTimingStream& Other, int32 Row )
+	{
+		CountGrowth();
+		Alpha.Add( Other.Alpha[ Row ] );
+		Duration.Add( Other.Duration[ Row ] );
+		Delay.Add( Other.Delay[ Row ] );
+		EasedAlpha.Add( Other.EasedAlpha[ Row ] );
+		EasingParam.Add( Other.EasingParam[ Row ] );
+		EasingPeriod.Add( Other.EasingPeriod[ Row ] );
+		EasingType.Add( Other.EasingType[ Row ] );
+		EasingFunction.Add( Other.EasingFunction[ Row ] );
+		EasingTable.Add( Other.EasingTable[ Row ] );
+		Flags.Add( Other.Flags[ Row ] );
+		Sequence.Add( Other.Sequence[ Row ] );
+		UpdateInterval.Add( Other.UpdateInterval[ Row ] );
+		UpdateCountdown.Add( Other.UpdateCountdown[ Row ] );
+		PendingTime.Add( Other.PendingTime[ Row ] );
+		LastApplied.Add( Other.LastApplied[ Row ] );
+		return SlotIndex.Add( Other.SlotIndex[ Row ] );
+	}
+
+	// Moves the last row into Row, returns the slot index of the row that moved or INDEX_NONE
+	int32 RemoveAtSwap( int32 Row )
+	{
+		const int32 LastRow = Num() - 1;
+		Alpha.RemoveAtSwap( Row, 1, false );
+		Duration.RemoveAtSwap( Row, 1, false );
+		Delay.RemoveAtSwap( Row, 1, false );
+		EasedAlpha.RemoveAtSwap( Row, 1, false );
+		EasingParam.RemoveAtSwap( Row, 1, false );
+		EasingPeriod.RemoveAtSwap( Row, 1, false );
+		EasingType.RemoveAtSwap( Row, 1, false );
+		EasingFunction.RemoveAtSwap( Row, 1, false );
+		EasingTable.RemoveAtSwap( Row, 1, false );
+		Flags.RemoveAtSwap( Row, 1, false );
+		Sequence.RemoveAtSwap( Row, 1, false );
+		UpdateInterval.RemoveAtSwap( Row, 1, false );
+		UpdateCountdown.RemoveAtSwap( Row, 1, false );
+		PendingTime.RemoveAtSwap( Row, 1, false );
+		LastApplied.RemoveAtSwap( Row, 1, false );
+		SlotIndex.RemoveAtSwap( Row, 1, false );
+		return Row != LastRow ? SlotIndex[ Row ] : INDEX_NONE;
+	}
+
+	void Reserve( int32 NumRows )
+	{
+		Alpha.Reserve( NumRows );
+		Duration.Reserve( NumRows );
+		Delay.Reserve( NumRows );
+		EasedAlpha.Reserve( NumRows );
+		EasingParam.Reserve( NumRows );
+		EasingPeriod.Reserve( NumRows );
+		EasingType.Reserve( NumRows );
+		EasingFunction.Reserve( NumRows );
+		EasingTable.Reserve( NumRows );
+		Flags.Reserve( NumRows );
+		Sequence.Reserve( NumRows );
+		UpdateInterval.Reserve( NumRows );
+		UpdateCountdown.Reserve( NumRows );
+		PendingTime.Reserve( NumRows );
+		LastApplied.Reserve( NumRows );
+		SlotIndex.Reserve( NumRows );
+		BatchRows.Reserve( NumRows );
+		BatchTime.Reserve( NumRows );
+		BatchDuration.Reserve( NumRows );
+		BatchOut.Reserve( NumRows );
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Alpha.GetAllocatedSize() + Duration.GetAllocatedSize() + Delay.GetAllocatedSize() + EasedAlpha.GetAllocatedSize()
+			+ EasingParam.GetAllocatedSize() + EasingPeriod.GetAllocatedSize() + EasingType.GetAllocatedSize()
+			+ EasingFunction.GetAllocatedSize() + EasingTable.GetAllocatedSize() + Flags.GetAllocatedSize()
+			+ Sequence.GetAllocatedSize() + UpdateInterval.GetAllocatedSize() + UpdateCountdown.GetAllocatedSize()
+			+ PendingTime.GetAllocatedSize() + LastApplied.GetAllocatedSize() + SlotIndex.GetAllocatedSize() + BatchRows.GetAllocatedSize()
+			+ BatchTime.GetAllocatedSize() + BatchDuration.GetAllocatedSize() + BatchOut.GetAllocatedSize();
+	}
+
+	void Empty()
+	{
+		Alpha.Empty();
+		Duration.Empty();
+		Delay.Empty();
+		EasedAlpha.Empty();
+		EasingParam.Empty();
+		EasingPeriod.Empty();
+		EasingType.Empty();
+		EasingFunction.Empty();
+		EasingTable.Empty();
+		Flags.Empty();
+		Sequence.Empty();
+		UpdateInterval.Empty();
+		UpdateCountdown.Empty();
+		PendingTime.Empty();
+		LastApplied.Empty();
+		SlotIndex.Empty();
+	}
+
+	int32 Num() const { return SlotIndex.Num(); }
+
+	// Times the rows or the Ease() scratch have had to grow since the stream was created. Reserve() doesn't count.
+	int32 GetNumGrowths() const { return NumGrowths; }
+
+	// Adds DeltaTime to every running row in [BeginRow, EndRow) and flags it NeedsApply, and Complete once it
+	// reaches its duration. Rows with an UpdateInterval bank the time instead until their countdown runs
+	// out or the banked time would finish them. Rows are independent, so disjoint ranges can be advanced on different threads.
+	void Advance( int32 BeginRow, int32 EndRow, float DeltaTime );
+
+	// Jumps every live row in [BeginRow, EndRow) to its end and flags it NeedsApply and Complete, paused or
+	// not, for FBUITweenManager::CompleteAll
+	void Finish( int32 BeginRow, int32 EndRow );
+
+	// Row's easing at T between 0 and 1, with its table if it has one
+	float EaseAt( int32 Row, float T ) const
+	{
+		return EasingTable[ Row ] ? EasingTable[ Row ]->Sample( T ) : EasingFunction[ Row ]( T, EasingParam[ Row ], EasingPeriod[ Row ] );
+	}
+
+	// Ease() one row at a time without the batching, for the ranges FBUITweenManager eases in parallel
+	void EaseRows( int32 BeginRow, int32 EndRow );
+
+	// Fills EasedAlpha for the first NumRows rows flagged NeedsApply. Rows with a baked table sample it,
+	// the rest are bucketed by easing type and each bucket is evaluated with FBUIEasing::EaseBatch. Rows
+	// with a custom easing param go one by one through the function resolved at Begin.
+	void Ease( int32 NumRows );
+
+	// Time elapsed since the delay ran out, clamped to Duration
+	TArray< float > Alpha;
+	TArray< float > Duration;
+	// Only read at Begin, delayed tweens then wait in FBUITweenGroup::DelayedStarts. For a paused delayed
+	// tween this is the time it has left.
+	TArray< float > Delay;
+	// Output of the easing pass
+	TArray< float > EasedAlpha;
+	TArray< float > EasingParam;
+	// Period relative to duration, see FBUIEasingFunction
+	TArray< float > EasingPeriod;
+	TArray< EBUIEasingType > EasingType;
+	// Resolved at Begin
+	TArray< FBUIEasingFunction > EasingFunction;
+	// Set at Begin when UBUITweenSettings::bUseEasingLookupTables is on or the tween has a curve easing.
+	// Holds the table alive, so the cache can be trimmed or emptied while tweens run.
+	TArray< FBUIEasingTablePtr > EasingTable;
+	TArray< EBUITweenTimingFlags > Flags;
+	// Increases with every Create, rows get reordered by compaction so this is what keeps callbacks in order
+	TArray< uint32 > Sequence;
+	// Seconds between advances for reduced-rate tweens, 0 for every update, see EBUITweenUpdateRate
+	TArray< float > UpdateInterval;
+	// Time left until the row next advances
+	TArray< float > UpdateCountdown;
+	// Time banked since the row last advanced, added to Alpha in one step when it does
+	TArray< float > PendingTime;
+	// FBUITweenManager update the row was last applied in, 0 if never. Rows waiting for the update budget
+	// are applied oldest first.
+	TArray< uint32 > LastApplied;
+	TArray< int32 > SlotIndex;
+
+private:
+	// Every row array grows in step, so SlotIndex speaks for all of them
+	void CountGrowth()
+	{
+		if ( SlotIndex.Num() == SlotIndex.Max() )
+		{
+			NumGrowths++;
+		}
+	}
+
+	// Scratch for Ease(), kept around so steady-state updates don't allocate
+	TArray< int32 > BatchRows;
+	TArray< float > BatchTime;
+	TArray< float > BatchDuration;
+	TArray< float > BatchOut;
+
+	int32 NumGrowths = 0;
+};
@@ -0,0 +1,25 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class BUITweenBenchmark : ModuleRules
+{
+	public BUITweenBenchmark(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"BUITween",
+				"Core",
+				"CoreUObject",
+				"DeveloperSettings",
+				"Engine",
+				"Slate",
+				"SlateCore",
+				"UMG"
+			}
+		);
+	}
+}
@@ -0,0 +1,632 @@
+#include "BUITweenBenchmarkCommandlet.h"
+
+#include "BUITweenManager.h"
+#include "BUITweenSettings.h"
+#include "BUIEasing.h"
+#include "BUIEasingTable.h"
+#include "Components/CanvasPanel.h"
+#include "Components/CanvasPanelSlot.h"
+#include "Components/Image.h"
+#include "Components/InvalidationBox.h"
+#include "Components/SizeBox.h"
+#include "Components/Spacer.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Input/HittestGrid.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Rendering/DrawElements.h"
+#include "UObject/Package.h"
+#include "Widgets/SWindow.h"
+
+DEFINE_LOG_CATEGORY( LogBUITweenBenchmark );
+
+namespace BUITweenBenchmark
+{
+	// Forwards to the real allocator and counts the allocations made on CountingThread while it is
+	// installed. Worker threads go through it too but aren't counted.
+	class FCountingMalloc : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc( FMalloc* InInner )
+			: Inner( InInner )
+		{
+		}
+
+		virtual void* Malloc( SIZE_T Count, uint32 Alignment ) override
+		{
+			if ( FPlatformTLS::GetCurrentThreadId() == CountingThread )
+			{
+				NumAllocations.Increment();
+			}
+			return Inner->Malloc( Count, Alignment );
+		}
+		virtual void* Realloc( void* Original, SIZE_T Count, uint32 Alignment ) override
+		{
+			if ( Count > 0 && FPlatformTLS::GetCurrentThreadId() == CountingThread )
+			{
+				NumAllocations.Increment();
+			}
+			return Inner->Realloc( Original, Count, Alignment );
+		}
+		virtual void Free( void* Original ) override
+		{
+			Inner->Free( Original );
+		}
+		virtual SIZE_T QuantizeSize( SIZE_T Count, uint32 Alignment ) override
+		{
+			return Inner->QuantizeSize( Count, Alignment );
+		}
+		virtual bool GetAllocationSize( void* Original, SIZE_T& SizeOut ) override
+		{
+			return Inner->GetAllocationSize( Original, SizeOut );
+		}
+		virtual void Trim( bool bTrimThreadCaches ) override
+		{
+			Inner->Trim( bTrimThreadCaches );
+		}
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return Inner->IsInternallyThreadSafe();
+		}
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return TEXT( "BUITweenBenchmarkCountingMalloc" );
+		}
+
+		FMalloc* Inner;
+		FThreadSafeCounter64 NumAllocations;
+		volatile uint32 CountingThread = 0;
+	};
+
+	// Installs a counting allocator for its lifetime, counting the calling thread's allocations. Everything
+	// allocated goes through the real allocator, so blocks can be freed after it is uninstalled.
+	struct FScopedAllocationCounter
+	{
+		FScopedAllocationCounter()
+		{
+			// Run whatever is queued for this thread first, so tasks started before the swap don't finish
+			// inside the counted section
+			FTaskGraphInterface::Get().ProcessThreadUntilIdle( ENamedThreads::GameThread );
+
+			FCountingMalloc& Counter = Get();
+			Counter.NumAllocations.Reset();
+			Counter.CountingThread = FPlatformTLS::GetCurrentThreadId();
+			FPlatformMisc::MemoryBarrier();
+			GMalloc = &Counter;
+		}
+		~FScopedAllocationCounter()
+		{
+			FCountingMalloc& Counter = Get();
+			GMalloc = Counter.Inner;
+			FPlatformMisc::MemoryBarrier();
+			Counter.CountingThread = 0;
+		}
+		int64 Num() const { return Get().NumAllocations.GetValue(); }
+
+		// Another thread may still be inside the counter's Malloc after it is uninstalled, so there is one
+		// instance for the whole process instead of one per scope
+		static FCountingMalloc& Get()
+		{
+			static FCountingMalloc Counter( GMalloc );
+			return Counter;
+		}
+	};
+
+	const TCHAR* GetWidgetName( EBUITweenBenchmarkWidget WidgetKind )
+	{
+		switch ( WidgetKind )
+		{
+			case EBUITweenBenchmarkWidget::Plain: return TEXT( "Plain" );
+			case EBUITweenBenchmarkWidget::Image: return TEXT( "Image" );
+			case EBUITweenBenchmarkWidget::CanvasSlot: return TEXT( "CanvasSlot" );
+			case EBUITweenBenchmarkWidget::CanvasSlotEmulated: return TEXT( "CanvasEmul" );
+			case EBUITweenBenchmarkWidget::SizeBox: return TEXT( "SizeBox" );
+		}
+		return TEXT( "Unknown" );
+	}
+
+	// Keeps the compiler from dropping easing evaluations whose results are otherwise unused
+	volatile float Sink = 0;
+}
+
+UBUITweenBenchmarkCommandlet::UBUITweenBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UBUITweenBenchmarkCommandlet::Main( const FString& Params )
+{
+	using namespace BUITweenBenchmark;
+
+	TArray< int32 > TweenCounts = { 1000, 10000, 50000, 100000 };
+	FString TweensParam;
+	if ( FParse::Value( *Params, TEXT( "Tweens=" ), TweensParam, false ) )
+	{
+		TArray< FString > Parts;
+		TweensParam.ParseIntoArray( Parts, TEXT( "," ) );
+		TweenCounts.Reset();
+		for ( const FString& Part : Parts )
+		{
+			TweenCounts.Add( FMath::Max( FCString::Atoi( *Part ), 1 ) );
+		}
+	}
+
+	int32 NumFrames = 600;
+	FParse::Value( *Params, TEXT( "Frames=" ), NumFrames );
+	NumFrames = FMath::Max( NumFrames, 1 );
+
+	const float DeltaTime = 1.0f / 60.0f;
+	float Duration = NumFrames * DeltaTime;
+	FParse::Value( *Params, TEXT( "Duration=" ), Duration );
+
+	TArray< EBUITweenBenchmarkWidget > WidgetKinds = { EBUITweenBenchmarkWidget::Plain, EBUITweenBenchmarkWidget::Image, EBUITweenBenchmarkWidget::CanvasSlot, EBUITweenBenchmarkWidget::CanvasSlotEmulated, EBUITweenBenchmarkWidget::SizeBox };
+	FString WidgetsParam;
+	if ( FParse::Value( *Params, TEXT( "Widgets=" ), WidgetsParam, false ) )
+	{
+		TArray< FString > Parts;
+		WidgetsParam.ParseIntoArray( Parts, TEXT( "," ) );
+		WidgetKinds.Reset();
+		for ( const FString& Part : Parts )
+		{
+			for ( EBUITweenBenchmarkWidget Kind : { EBUITweenBenchmarkWidget::Plain, EBUITweenBenchmarkWidget::Image, EBUITweenBenchmarkWidget::CanvasSlot, EBUITweenBenchmarkWidget::CanvasSlotEmulated, EBUITweenBenchmarkWidget::SizeBox } )
+			{
+				if ( Part.Equals( GetWidgetName( Kind ), ESearchCase::IgnoreCase ) )
+				{
+					WidgetKinds.Add( Kind );
+				}
+			}
+		}
+	}
+
+	// Restored at the end, the settings object outlives the commandlet in the editor
+	UBUITweenSettings* Settings = GetMutableDefault<UBUITweenSettings>();
+	const int32 ParallelUpdateThreshold = Settings->ParallelUpdateThreshold;
+	FParse::Value( *Params, TEXT( "ParallelThreshold=" ), Settings->ParallelUpdateThreshold );
+
+	TArray< FString > CsvLines;
+	CsvLines.Add( TEXT( "Widget,Tweens,Frames,NsPerTweenFrame,CreateMs,UpdateMs,SteadyStateAllocations,BUITweenAllocations,SetterCalls,SetterCallsSkipped,BUITweenBytes,UsedPhysicalGrowthMB" ) );
+
+	UE_LOG( LogBUITweenBenchmark, Display, TEXT( "%-10s %8s %7s %12s %10s %10s %8s %8s %10s %10s %10s %8s" ),
+		TEXT( "Widget" ), TEXT( "Tweens" ), TEXT( "Frames" ), TEXT( "ns/tw/frm" ), TEXT( "CreateMs" ), TEXT( "UpdateMs" ),
+		TEXT( "Allocs" ), TEXT( "TwAllocs" ), TEXT( "Setters" ), TEXT( "Skipped" ), TEXT( "TweenKB" ), TEXT( "GrowthMB" ) );
+
+	for ( EBUITweenBenchmarkWidget WidgetKind : WidgetKinds )
+	{
+		for ( int32 NumTweens : TweenCounts )
+		{
+			const FResult Result = RunTweens( WidgetKind, NumTweens, NumFrames, Duration );
+			const double NsPerTweenFrame = Result.UpdateSeconds * 1.e9 / ( (double)Result.NumTweens * Result.NumFrames );
+			const double GrowthMB = Result.UsedPhysicalGrowth / ( 1024.0 * 1024.0 );
+
+			UE_LOG( LogBUITweenBenchmark, Display, TEXT( "%-10s %8d %7d %12.1f %10.2f %10.2f %8lld %8d %10lld %10lld %10.1f %8.1f" ),
+				GetWidgetName( WidgetKind ), Result.NumTweens, Result.NumFrames, NsPerTweenFrame,
+				Result.CreateSeconds * 1000.0, Result.UpdateSeconds * 1000.0, Result.SteadyStateAllocations, Result.BUITweenAllocations,
+				Result.SetterCallsIssued, Result.SetterCallsSkipped, Result.BUITweenBytes / 1024.0, GrowthMB );
+
+			CsvLines.Add( FString::Printf( TEXT( "%s,%d,%d,%f,%f,%f,%lld,%d,%lld,%lld,%llu,%f" ),
+				GetWidgetName( WidgetKind ), Result.NumTweens, Result.NumFrames, NsPerTweenFrame,
+				Result.CreateSeconds * 1000.0, Result.UpdateSeconds * 1000.0, Result.SteadyStateAllocations, Result.BUITweenAllocations,
+				Result.SetterCallsIssued, Result.SetterCallsSkipped, (uint64)Result.BUITweenBytes, GrowthMB ) );
+		}
+	}
+
+	if ( !FParse::Param( *Params, TEXT( "NoStagger" ) ) )
+	{
+		RunStagger( TweenCounts, CsvLines );
+	}
+
+	if ( !FParse::Param( *Params, TEXT( "NoEasing" ) ) )
+	{
+		RunEasing( CsvLines );
+	}
+
+	if ( !FParse::Param( *Params, TEXT( "NoSlate" ) ) )
+	{
+		RunSlate( TweenCounts, NumFrames, CsvLines );
+	}
+
+	Settings->ParallelUpdateThreshold = ParallelUpdateThreshold;
+
+	FString CsvPath;
+	if ( FParse::Value( *Params, TEXT( "Csv=" ), CsvPath ) )
+	{
+		if ( !FFileHelper::SaveStringArrayToFile( CsvLines, *CsvPath ) )
+		{
+			UE_LOG( LogBUITweenBenchmark, Error, TEXT( "Could not write %s" ), *CsvPath );
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+UWidget* UBUITweenBenchmarkCommandlet::CreateWidget( EBUITweenBenchmarkWidget WidgetKind, UObject* Outer, UCanvasPanel* Canvas )
+{
+	switch ( WidgetKind )
+	{
+		case EBUITweenBenchmarkWidget::Image:
+			return NewObject<UImage>( Outer );
+		case EBUITweenBenchmarkWidget::CanvasSlot:
+		case EBUITweenBenchmarkWidget::CanvasSlotEmulated:
+		{
+			USpacer* Spacer = NewObject<USpacer>( Outer );
+			Canvas->AddChildToCanvas( Spacer );
+			return Spacer;
+		}
+		case EBUITweenBenchmarkWidget::SizeBox:
+			return NewObject<USizeBox>( Outer );
+		default:
+			return NewObject<USpacer>( Outer );
+	}
+}
+
+UBUITweenBenchmarkCommandlet::FResult UBUITweenBenchmarkCommandlet::RunTweens( EBUITweenBenchmarkWidget WidgetKind, int32 NumTweens, int32 NumFrames, float Duration )
+{
+	using namespace BUITweenBenchmark;
+
+	const float DeltaTime = 1.0f / 60.0f;
+
+	// Measured from here rather than with the process-lifetime peak, which only ever shows the largest
+	// earlier run
+	const uint64 UsedPhysicalBefore = FPlatformMemory::GetStats().UsedPhysical;
+
+	// A manager of our own, so every run starts from the configured initial capacity and is stepped on a
+	// fixed clock regardless of how long each frame takes
+	FBUITweenManager Manager;
+	Manager.SetFixedStep( DeltaTime );
+
+	UPackage* Outer = GetTransientPackage();
+	UCanvasPanel* Canvas = NewObject<UCanvasPanel>( Outer );
+	Canvas->AddToRoot();
+
+	TArray< UWidget* > Widgets;
+	Widgets.Reserve( NumTweens );
+	for ( int32 i = 0; i < NumTweens; ++i )
+	{
+		UWidget* Widget = CreateWidget( WidgetKind, Outer, Canvas );
+		Widget->AddToRoot();
+		Widgets.Add( Widget );
+	}
+
+	FResult Result = {};
+	Result.Widget = WidgetKind;
+	Result.NumTweens = NumTweens;
+	Result.NumFrames = NumFrames;
+
+	const double CreateStart = FPlatformTime::Seconds();
+	for ( int32 i = 0; i < NumTweens; ++i )
+	{
+		// Spread the start values so setters aren't skipped just because every widget matches
+		const float Offset = (float)( i % 100 );
+		FBUITweenHandle Handle = Manager.Create( Widgets[ i ], Duration );
+		switch ( WidgetKind )
+		{
+			case EBUITweenBenchmarkWidget::Plain:
+				Handle.FromTranslation( -Offset, 0 ).ToTranslation( Offset, 50 )
+					.FromScale( FVector2D( 0.5f, 0.5f ) ).ToScale( FVector2D::UnitVector )
+					.FromOpacity( 0 ).ToOpacity( 1 );
+				break;
+			case EBUITweenBenchmarkWidget::Image:
+				Handle.FromColor( FLinearColor::Black ).ToColor( FLinearColor( Offset / 100.0f, 1, 1, 1 ) )
+					.FromOpacity( 0 ).ToOpacity( 1 );
+				break;
+			case EBUITweenBenchmarkWidget::CanvasSlot:
+				Handle.FromCanvasPosition( FVector2D( Offset, 0 ) ).ToCanvasPosition( FVector2D( Offset, 400 ) );
+				break;
+			case EBUITweenBenchmarkWidget::CanvasSlotEmulated:
+				Handle.FromCanvasPosition( FVector2D( Offset, 0 ) ).ToCanvasPosition( FVector2D( Offset, 400 ) ).EmulateLayout();
+				break;
+			case EBUITweenBenchmarkWidget::SizeBox:
+				Handle.FromMaxDesiredHeight( Offset ).ToMaxDesiredHeight( 400 );
+				break;
+		}
+		Handle.Easing( (EBUIEasingType)( i % FBUIEasing::NumEasingTypes ) ).Begin();
+	}
+	Result.CreateSeconds = FPlatformTime::Seconds() - CreateStart;
+	uint64 UsedPhysicalMax = FPlatformMemory::GetStats().UsedPhysical;
+
+	// The first frame pays for anything lazily set up, like easing tables, so it is timed but not counted
+	// towards steady-state allocations
+	double UpdateSeconds = 0;
+	{
+		const double FrameStart = FPlatformTime::Seconds();
+		Manager.Step( DeltaTime );
+		UpdateSeconds += FPlatformTime::Seconds() - FrameStart;
+		Result.SetterCallsIssued += Manager.GetWriteCounters().Issued;
+		Result.SetterCallsSkipped += Manager.GetWriteCounters().Skipped;
+		Result.BUITweenAllocations += Manager.GetAllocationCounters().Num();
+	}
+
+	{
+		FScopedAllocationCounter Allocations;
+		for ( int32 Frame = 1; Frame < NumFrames; ++Frame )
+		{
+			const double FrameStart = FPlatformTime::Seconds();
+			Manager.Step( DeltaTime );
+			UpdateSeconds += FPlatformTime::Seconds() - FrameStart;
+
+			// Reading the counters doesn't allocate, so this doesn't disturb the allocation count
+			Result.SetterCallsIssued += Manager.GetWriteCounters().Issued;
+			Result.SetterCallsSkipped += Manager.GetWriteCounters().Skipped;
+			Result.BUITweenAllocations += Manager.GetAllocationCounters().Num();
+		}
+		Result.SteadyStateAllocations = Allocations.Num();
+	}
+	Result.UpdateSeconds = UpdateSeconds;
+	Result.BUITweenBytes = Manager.GetAllocatedSize();
+	UsedPhysicalMax = FMath::Max( UsedPhysicalMax, FPlatformMemory::GetStats().UsedPhysical );
+	Result.UsedPhysicalGrowth = (int64)UsedPhysicalMax - (int64)UsedPhysicalBefore;
+
+	for ( UWidget* Widget : Widgets )
+	{
+		Widget->RemoveFromRoot();
+	}
+	Canvas->RemoveFromRoot();
+	Manager.Empty();
+	CollectGarbage( RF_NoFlags );
+
+	return Result;
+}
+
+void UBUITweenBenchmarkCommandlet::RunEasing( TArray< FString >& CsvLines )
+{
+	using namespace BUITweenBenchmark;
+
+	// Same inputs for every method, spread over the whole curve
+	const int32 NumSamples = 1 << 20;
+	TArray< float > Time;
+	TArray< float > Duration;
+	TArray< float > Out;
+	Time.SetNumUninitialized( NumSamples );
+	Duration.SetNumUninitialized( NumSamples );
+	Out.SetNumUninitialized( NumSamples );
+	for ( int32 i = 0; i < NumSamples; ++i )
+	{
+		Time[ i ] = (float)( i % 1000 ) / 1000.0f;
+		Duration[ i ] = 1.0f;
+	}
+
+	CsvLines.Add( TEXT( "" ) );
+	CsvLines.Add( TEXT( "Easing,SwitchNs,ResolvedNs,BatchNs,TableNs,TableMaxError" ) );
+	UE_LOG( LogBUITweenBenchmark, Display, TEXT( "%-14s %10s %10s %10s %10s %12s" ),
+		TEXT( "Easing" ), TEXT( "Switch ns" ), TEXT( "Resolved" ), TEXT( "Batch" ), TEXT( "Table" ), TEXT( "TableError" ) );
+
+	const UEnum* EasingEnum = StaticEnum<EBUIEasingType>();
+	for ( int32 TypeIndex = 0; TypeIndex < FBUIEasing::NumEasingTypes; ++TypeIndex )
+	{
+		const EBUIEasingType Type = (EBUIEasingType)TypeIndex;
+		float Sum = 0;
+
+		double Start = FPlatformTime::Seconds();
+		for ( int32 i = 0; i < NumSamples; ++i )
+		{
+			Sum += FBUIEasing::Ease( Type, Time[ i ], Duration[ i ] );
+		}
+		const double SwitchNs = ( FPlatformTime::Seconds() - Start ) * 1.e9 / NumSamples;
+
+		const FBUIEasingFunction Function = FBUIEasing::Resolve( Type );
+		Start = FPlatformTime::Seconds();
+		for ( int32 i = 0; i < NumSamples; ++i )
+		{
+			Sum += Function( Time[ i ], 0.1f, 1.0f );
+		}
+		const double ResolvedNs = ( FPlatformTime::Seconds() - Start ) * 1.e9 / NumSamples;
+
+		Start = FPlatformTime::Seconds();
+		FBUIEasing::EaseBatch( Type, Time.GetData(), Duration.GetData(), Out.GetData(), NumSamples );
+		const double BatchNs = ( FPlatformTime::Seconds() - Start ) * 1.e9 / NumSamples;
+		Sum += Out[ NumSamples / 2 ];
+
+		const FBUIEasingTable& Table = *FBUIEasingTableCache::Get( Type );
+		Start = FPlatformTime::Seconds();
+		for ( int32 i = 0; i < NumSamples; ++i )
+		{
+			Sum += Table.Sample( Time[ i ] );
+		}
+		const double TableNs = ( FPlatformTime::Seconds() - Start ) * 1.e9 / NumSamples;
+
+		Sink = Sum;
+
+		const FString Name = EasingEnum ? EasingEnum->GetNameStringByValue( TypeIndex ) : FString::FromInt( TypeIndex );
+		UE_LOG( LogBUITweenBenchmark, Display, TEXT( "%-14s %10.2f %10.2f %10.2f %10.2f %12.6f" ),
+			*Name, SwitchNs, ResolvedNs, BatchNs, TableNs, Table.GetMaxError() );
+		CsvLines.Add( FString::Printf( TEXT( "%s,%f,%f,%f,%f,%f" ), *Name, SwitchNs, ResolvedNs, BatchNs, TableNs, Table.GetMaxError() ) );
+	}
+}
+
+void UBUITweenBenchmarkCommandlet::RunStagger( const TArray< int32 >& WidgetCounts, TArray< FString >& CsvLines )
+{
+	const float DeltaTime = 1.0f / 60.0f;
+	const float Duration = 0.3f;
+
+	// Storage is measured from empty, so the configured initial capacity doesn't hide it
+	UBUITweenSettings* Settings = GetMutableDefault<UBUITweenSettings>();
+	const int32 InitialTweenCapacity = Settings->InitialTweenCapacity;
+	Settings->InitialTweenCapacity = 0;
+
+	CsvLines.Add( TEXT( "" ) );
+	CsvLines.Add( TEXT( "StaggerMode,Widgets,Frames,CreateMs,UpdateMs,BytesPerWidget" ) );
+	UE_LOG( LogBUITweenBenchmark, Display, TEXT( "%-10s %8s %7s %10s %10s %10s" ),
+		TEXT( "Stagger" ), TEXT( "Widgets" ), TEXT( "Frames" ), TEXT( "CreateMs" ), TEXT( "UpdateMs" ), TEXT( "B/widget" ) );
+
+	UPackage* Outer = GetTransientPackage();
+	for ( int32 NumWidgets : WidgetCounts )
+	{
+		UCanvasPanel* Canvas = NewObject<UCanvasPanel>( Outer );
+		Canvas->AddToRoot();
+		TArray< UWidget* > Widgets;
+		Widgets.Reserve( NumWidgets );
+		for ( int32 i = 0; i < NumWidgets; ++i )
+		{
+			UWidget* Widget = CreateWidget( EBUITweenBenchmarkWidget::Plain, Outer, Canvas );
+			Widget->AddToRoot();
+			Widgets.Add( Widget );
+		}
+
+		// Long lists are spread over a second so the run stays short
+		const float PerItemDelay = FMath::Min( 0.02f, 1.0f / NumWidgets );
+
+		// Enough frames for the last widget to finish
+		const int32 NumFrames = FMath::CeilToInt( ( Duration + ( NumWidgets - 1 ) * PerItemDelay ) / DeltaTime ) + 1;
+
+		for ( bool bStaggered : { false, true } )
+		{
+			FBUITweenManager Manager;
+			Manager.SetFixedStep( DeltaTime );
+			const SIZE_T BytesBefore = Manager.GetAllocatedSize();
+
+			const double CreateStart = FPlatformTime::Seconds();
+			SIZE_T SharedBytes = 0;
+			if ( bStaggered )
+			{
+				FBUITweenHandle Handle = Manager.CreateStaggered( Widgets, Duration, PerItemDelay );
+				Handle.FromTranslation( -40, 0 ).ToTranslation( 0, 0 ).FromOpacity( 0 ).ToOpacity( 1 ).Easing( EBUIEasingType::OutCubic ).Begin();
+				SharedBytes = Handle.Resolve()->GetStaggerTargets().GetAllocatedSize();
+			}
+			else
+			{
+				for ( int32 i = 0; i < NumWidgets; ++i )
+				{
+					Manager.Create( Widgets[ i ], Duration, i * PerItemDelay )
+						.FromTranslation( -40, 0 ).ToTranslation( 0, 0 ).FromOpacity( 0 ).ToOpacity( 1 ).Easing( EBUIEasingType::OutCubic ).Begin();
+				}
+			}
+			const double CreateSeconds = FPlatformTime::Seconds() - CreateStart;
+			const double BytesPerWidget = (double)( Manager.GetAllocatedSize() - BytesBefore + SharedBytes ) / NumWidgets;
+
+			const double UpdateStart = FPlatformTime::Seconds();
+			for ( int32 Frame = 0; Frame < NumFrames; ++Frame )
+			{
+				Manager.Step( DeltaTime );
+			}
+			const double UpdateSeconds = FPlatformTime::Seconds() - UpdateStart;
+
+			const TCHAR* Mode = bStaggered ? TEXT( "Staggered" ) : TEXT( "Create" );
+			UE_LOG( LogBUITweenBenchmark, Display, TEXT( "%-10s %8d %7d %10.2f %10.2f %10.1f" ),
+				Mode, NumWidgets, NumFrames, CreateSeconds * 1000.0, UpdateSeconds * 1000.0, BytesPerWidget );
+			CsvLines.Add( FString::Printf( TEXT( "%s,%d,%d,%f,%f,%f" ),
+				Mode, NumWidgets, NumFrames, CreateSeconds * 1000.0, UpdateSeconds * 1000.0, BytesPerWidget ) );
+		}
+
+		for ( UWidget* Widget : Widgets )
+		{
+			Widget->RemoveFromRoot();
+		}
+		Canvas->RemoveFromRoot();
+		CollectGarbage( RF_NoFlags );
+	}
+
+	Settings->InitialTweenCapacity = InitialTweenCapacity;
+}
+
+void UBUITweenBenchmarkCommandlet::RunSlate( const TArray< int32 >& WidgetCounts, int32 NumFrames, TArray< FString >& CsvLines )
+{
+	// Painting needs the Slate application, which commandlets only create with -AllowCommandletRendering
+	if ( !FSlateApplication::IsInitialized() )
+	{
+		UE_LOG( LogBUITweenBenchmark, Display, TEXT( "Slate is not initialized, skipping the prepass and paint comparison. Run with -AllowCommandletRendering to include it." ) );
+		return;
+	}
+
+	const float DeltaTime = 1.0f / 60.0f;
+	const float Duration = NumFrames * DeltaTime;
+	const FVector2D ViewportSize( 1920, 1080 );
+
+	UBUITweenSettings* Settings = GetMutableDefault<UBUITweenSettings>();
+	const bool bWriteSlateDirectly = Settings->bWriteSlateDirectly;
+
+	CsvLines.Add( TEXT( "" ) );
+	CsvLines.Add( TEXT( "SlateWrites,Widgets,Frames,UpdateMs,PrepassMs,PaintMs,SetterCalls" ) );
+	UE_LOG( LogBUITweenBenchmark, Display, TEXT( "%-10s %8s %7s %10s %10s %10s %10s" ),
+		TEXT( "Writes" ), TEXT( "Widgets" ), TEXT( "Frames" ), TEXT( "UpdateMs" ), TEXT( "PrepassMs" ), TEXT( "PaintMs" ), TEXT( "Setters" ) );
+
+	UPackage* Outer = GetTransientPackage();
+	for ( int32 NumWidgets : WidgetCounts )
+	{
+		for ( bool bDirect : { false, true } )
+		{
+			Settings->bWriteSlateDirectly = bDirect;
+
+			// Fresh widgets for each mode, so both start from the same cached state
+			UInvalidationBox* Box = NewObject<UInvalidationBox>( Outer );
+			Box->SetCanCache( true );
+			Box->AddToRoot();
+			UCanvasPanel* Canvas = NewObject<UCanvasPanel>( Outer );
+			Box->AddChild( Canvas );
+
+			TArray< UWidget* > Widgets;
+			Widgets.Reserve( NumWidgets );
+			for ( int32 i = 0; i < NumWidgets; ++i )
+			{
+				UImage* Image = NewObject<UImage>( Outer );
+				Canvas->AddChildToCanvas( Image );
+				Widgets.Add( Image );
+			}
+
+			const TSharedRef<SWidget> Root = Box->TakeWidget();
+			const TSharedRef<SWindow> Window = SNew( SWindow )
+				.ClientSize( ViewportSize )
+				.CreateTitleBar( false )
+				[
+					Root
+				];
+			FSlateWindowElementList ElementList( Window );
+			FHittestGrid HittestGrid;
+			const FGeometry Geometry = FGeometry::MakeRoot( ViewportSize, FSlateLayoutTransform() );
+			const FSlateRect CullingRect( FVector2D::ZeroVector, ViewportSize );
+
+			FBUITweenManager Manager;
+			Manager.SetFixedStep( DeltaTime );
+			for ( int32 i = 0; i < NumWidgets; ++i )
+			{
+				const float Offset = (float)( i % 100 );
+				Manager.Create( Widgets[ i ], Duration )
+					.FromTranslation( -Offset, 0 ).ToTranslation( Offset, 50 )
+					.FromOpacity( 0 ).ToOpacity( 1 )
+					.Begin();
+			}
+
+			double UpdateSeconds = 0;
+			double PrepassSeconds = 0;
+			double PaintSeconds = 0;
+			int64 SetterCalls = 0;
+			for ( int32 Frame = 0; Frame < NumFrames; ++Frame )
+			{
+				const double FrameStart = FPlatformTime::Seconds();
+				Manager.Step( DeltaTime );
+				const double PrepassStart = FPlatformTime::Seconds();
+				Root->SlatePrepass( 1.0f );
+				const double PaintStart = FPlatformTime::Seconds();
+				ElementList.ResetElementList();
+				FPaintArgs PaintArgs( &Window.Get(), HittestGrid, FVector2D::ZeroVector, FApp::GetCurrentTime(), DeltaTime );
+				Root->Paint( PaintArgs, Geometry, CullingRect, ElementList, 0, FWidgetStyle(), true );
+				const double PaintEnd = FPlatformTime::Seconds();
+
+				UpdateSeconds += PrepassStart - FrameStart;
+				PrepassSeconds += PaintStart - PrepassStart;
+				PaintSeconds += PaintEnd - PaintStart;
+				SetterCalls += Manager.GetWriteCounters().Issued;
+			}
+
+			const TCHAR* Mode = bDirect ? TEXT( "Slate" ) : TEXT( "UMG" );
+			UE_LOG( LogBUITweenBenchmark, Display, TEXT( "%-10s %8d %7d %10.2f %10.2f %10.2f %10lld" ),
+				Mode, NumWidgets, NumFrames, UpdateSeconds * 1000.0, PrepassSeconds * 1000.0, PaintSeconds * 1000.0, SetterCalls );
+			CsvLines.Add( FString::Printf( TEXT( "%s,%d,%d,%f,%f,%f,%lld" ),
+				Mode, NumWidgets, NumFrames, UpdateSeconds * 1000.0, PrepassSeconds * 1000.0, PaintSeconds * 1000.0, SetterCalls ) );
+
+			Manager.Empty();
+			Box->ReleaseSlateResources( true );
+			Box->RemoveFromRoot();
+			CollectGarbage( RF_NoFlags );
+		}
+	}
+
+	Settings->bWriteSlateDirectly = bWriteSlateDirectly;
+}
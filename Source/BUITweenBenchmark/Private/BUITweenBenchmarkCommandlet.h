@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BUITweenBenchmarkCommandlet.generated.h"
+
+class UWidget;
+
+DECLARE_LOG_CATEGORY_EXTERN( LogBUITweenBenchmark, Log, All );
+
+enum class EBUITweenBenchmarkWidget : uint8
+{
+	// No color or slot binding, tweens translation, scale and opacity
+	Plain,
+	// Tweens color and opacity
+	Image,
+	// Child of a canvas panel, tweens the slot position
+	CanvasSlot,
+	// Same canvas position tween played as a render offset, see FBUITweenInstance::EmulateLayout
+	CanvasSlotEmulated,
+	// Tweens max desired height
+	SizeBox,
+};
+
+// Steps an FBUITweenManager over real widgets without an engine tick and reports the cost.
+//
+// UnrealEditor-Cmd <Project> -run=BUITweenBenchmark -nullrhi -unattended
+//	-Tweens=1000,10000,50000,100000	Tween counts to run, one tween per widget
+//	-Frames=600					Updates per run, at 60Hz
+//	-Duration=<seconds>			Tween duration, defaults to Frames / 60 so everything completes on the last frame
+//	-Widgets=Plain,Image,CanvasSlot,CanvasEmul,SizeBox
+//	-ParallelThreshold=<count>	Overrides UBUITweenSettings::ParallelUpdateThreshold for the run
+//	-NoStagger					Skip the CreateStaggered versus one Create per widget comparison
+//	-NoEasing					Skip the easing evaluation comparison
+//	-NoSlate					Skip the Slate prepass and paint comparison, which also needs -AllowCommandletRendering
+//	-Csv=<path>					Also write the results as CSV
+UCLASS()
+class UBUITweenBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBUITweenBenchmarkCommandlet();
+
+	virtual int32 Main( const FString& Params ) override;
+
+private:
+	struct FResult
+	{
+		EBUITweenBenchmarkWidget Widget;
+		int32 NumTweens;
+		int32 NumFrames;
+		double CreateSeconds;
+		double UpdateSeconds;
+		// Heap allocations on the game thread while updating, after the first frame
+		int64 SteadyStateAllocations;
+		int32 BUITweenAllocations;
+		int64 SetterCallsIssued;
+		int64 SetterCallsSkipped;
+		SIZE_T BUITweenBytes;
+		// Physical memory in use after creating the tweens or after the last frame, whichever is larger,
+		// minus what was in use before the run
+		int64 UsedPhysicalGrowth;
+	};
+
+	FResult RunTweens( EBUITweenBenchmarkWidget WidgetKind, int32 NumTweens, int32 NumFrames, float Duration );
+	UWidget* CreateWidget( EBUITweenBenchmarkWidget WidgetKind, UObject* Outer, class UCanvasPanel* Canvas );
+	// Animates a list of widgets in with one CreateStaggered call and with one Create per widget
+	void RunStagger( const TArray< int32 >& WidgetCounts, TArray< FString >& CsvLines );
+	void RunEasing( TArray< FString >& CsvLines );
+	// Times Slate prepass and paint over tweened images inside an invalidation box, writing through the UMG
+	// setters and with UBUITweenSettings::bWriteSlateDirectly
+	void RunSlate( const TArray< int32 >& WidgetCounts, int32 NumFrames, TArray< FString >& CsvLines );
+};